@@ -0,0 +1,90 @@
+#include "alarm_history.h"
+#include "esphome/core/hal.h"
+
+namespace esphome {
+namespace haier {
+
+// Active time of long alarms is saved not more often than this
+constexpr uint32_t ALARM_HISTORY_SAVE_INTERVAL_MS = 600000;
+// Active time is not counted for bigger gaps between updates (communication problems)
+constexpr uint32_t MAX_UPDATE_GAP_MS = 3600000;
+
+bool AlarmHistory::restore() {
+  State stored;
+  bool restored = this->preference_.load(&stored) && (stored.head < HISTORY_SIZE) && (stored.count <= HISTORY_SIZE);
+  if (restored)
+    this->state_ = stored;
+  this->state_.boot_count++;
+  this->changed_ = true;
+  this->last_save_time_ = std::chrono::steady_clock::now();
+  return restored;
+}
+
+void AlarmHistory::update_active_time(uint64_t active_alarms, std::chrono::steady_clock::time_point now) {
+  if (this->has_update_ && (active_alarms != 0)) {
+    uint32_t interval_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - this->last_update_time_).count();
+    if (interval_ms <= MAX_UPDATE_GAP_MS) {
+      this->pending_ms_ += interval_ms;
+      uint32_t seconds = this->pending_ms_ / 1000;
+      this->pending_ms_ %= 1000;
+      if (seconds > 0) {
+        for (uint64_t alarms = active_alarms; alarms != 0; alarms &= alarms - 1)
+          this->state_.active_seconds[__builtin_ctzll(alarms)] += seconds;
+        this->changed_ = true;
+      }
+    }
+  } else {
+    this->pending_ms_ = 0;
+  }
+  this->has_update_ = true;
+  this->last_update_time_ = now;
+}
+
+void AlarmHistory::add_event(uint8_t code, bool active, uint32_t timestamp, std::chrono::steady_clock::time_point now) {
+  if (code >= ALARM_CODES)
+    return;
+  Event &event = this->state_.events[this->state_.head];
+  event.uptime_s = millis() / 1000;
+  event.timestamp = timestamp;
+  event.boot = this->state_.boot_count;
+  event.code = code;
+  event.active = active ? 1 : 0;
+  this->state_.head = (this->state_.head + 1) % HISTORY_SIZE;
+  if (this->state_.count < HISTORY_SIZE)
+    this->state_.count++;
+  if (active && (this->state_.occurrences[code] < UINT16_MAX))
+    this->state_.occurrences[code]++;
+  this->changed_ = true;
+  // Transitions are rare, save them right away
+  this->save(now, true);
+}
+
+void AlarmHistory::clear() {
+  uint16_t boot_count = this->state_.boot_count;
+  this->state_ = State{};
+  this->state_.boot_count = boot_count;
+  this->changed_ = true;
+}
+
+void AlarmHistory::save(std::chrono::steady_clock::time_point now, bool force) {
+  if (!this->changed_)
+    return;
+  if (!force && (std::chrono::duration_cast<std::chrono::milliseconds>(now - this->last_save_time_).count() <
+                 ALARM_HISTORY_SAVE_INTERVAL_MS))
+    return;
+  if (this->preference_.save(&this->state_)) {
+    this->saves_count_++;
+    this->changed_ = false;
+  }
+  this->last_save_time_ = now;
+}
+
+const AlarmHistory::Event &AlarmHistory::get_event(size_t index) const {
+  // Out of range index returns the oldest event
+  if (index >= this->state_.count)
+    index = this->state_.count > 0 ? this->state_.count - 1 : 0;
+  return this->state_.events[(this->state_.head + HISTORY_SIZE - 1 - index) % HISTORY_SIZE];
+}
+
+}  // namespace haier
+}  // namespace esphome
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "esphome/core/preferences.h"
+
+namespace esphome {
+namespace haier {
+
+// History of alarm transitions with per alarm code statistics. The whole state is one compact binary
+// structure stored in flash, it is saved after changes with minimal interval between saves.
+class AlarmHistory {
+ public:
+  static constexpr size_t HISTORY_SIZE = 16;
+  static constexpr size_t ALARM_CODES = 64;
+  struct Event {
+    uint32_t uptime_s;   // Uptime of the boot when the event happened
+    uint32_t timestamp;  // Unix time, 0 if time was unknown
+    uint16_t boot;       // Boot number, to tell apart uptimes of different boots
+    uint8_t code;
+    uint8_t active;  // 1 - alarm started, 0 - alarm ended
+  };
+  struct State {
+    uint16_t boot_count;
+    uint8_t head;   // Position for the next event
+    uint8_t count;  // Number of stored events
+    Event events[HISTORY_SIZE];
+    uint16_t occurrences[ALARM_CODES];
+    uint32_t active_seconds[ALARM_CODES];
+  };
+  void set_preference(ESPPreferenceObject preference) { this->preference_ = preference; };
+  // Loads saved state and starts new boot, returns false if there is no saved state
+  bool restore();
+  // Adds time passed since the previous call to all active alarms, should be called before active alarms change
+  void update_active_time(uint64_t active_alarms, std::chrono::steady_clock::time_point now);
+  void add_event(uint8_t code, bool active, uint32_t timestamp, std::chrono::steady_clock::time_point now);
+  void clear();
+  // Saves the state if it changed and save interval passed (or if forced)
+  void save(std::chrono::steady_clock::time_point now, bool force = false);
+  size_t size() const { return this->state_.count; };
+  // Index 0 is the newest event
+  const Event &get_event(size_t index) const;
+  uint16_t get_occurrences(uint8_t code) const { return code < ALARM_CODES ? this->state_.occurrences[code] : 0; };
+  uint32_t get_active_seconds(uint8_t code) const {
+    return code < ALARM_CODES ? this->state_.active_seconds[code] : 0;
+  };
+  uint16_t get_boot() const { return this->state_.boot_count; };
+  uint32_t get_saves_count() const { return this->saves_count_; };
+
+ protected:
+  ESPPreferenceObject preference_;
+  State state_{};
+  bool has_update_{false};
+  std::chrono::steady_clock::time_point last_update_time_;
+  uint32_t pending_ms_{0};  // Active time that is not added to counters yet
+  bool changed_{false};
+  std::chrono::steady_clock::time_point last_save_time_;
+  uint32_t saves_count_{0};
+};
+
+}  // namespace haier
+}  // namespace esphome
@@ -126,5 +126,23 @@ template<typename... Ts> class PowerToggleAction : public Action<Ts...> {
   HaierClimateBase *parent_;
 };
 
+template<typename... Ts> class DumpFrameCaptureAction : public Action<Ts...> {
+ public:
+  DumpFrameCaptureAction(HaierClimateBase *parent) : parent_(parent) {}
+  void play(const Ts &...x) { this->parent_->dump_frame_capture(); }
+
+ protected:
+  HaierClimateBase *parent_;
+};
+
+template<typename... Ts> class ClearFrameCaptureAction : public Action<Ts...> {
+ public:
+  ClearFrameCaptureAction(HaierClimateBase *parent) : parent_(parent) {}
+  void play(const Ts &...x) { this->parent_->clear_frame_capture(); }
+
+ protected:
+  HaierClimateBase *parent_;
+};
+
 }  // namespace haier
 }  // namespace esphome
@@ -10,6 +10,7 @@ from esphome.const import (
     CONF_CURRENT_TEMPERATURE,
     CONF_DISPLAY,
     CONF_ID,
+    CONF_INTERVAL,
     CONF_LEVEL,
     CONF_LOGGER,
     CONF_LOGS,
@@ -25,6 +26,7 @@ from esphome.const import (
     CONF_VISUAL,
     CONF_WIFI,
 )
+from esphome.core import CORE, ID
 from esphome.cpp_generator import MockObjClass
 import esphome.final_validate as fv
 
@@ -41,16 +43,30 @@ PROTOCOL_STATUS_MESSAGE_HEADER_SIZE = 0
 
 CODEOWNERS = ["@paveldn"]
 DEPENDENCIES = ["climate", "uart"]
+CONF_ALARM_STATUS_INTERVAL = "alarm_status_interval"
 CONF_ALTERNATIVE_SWING_CONTROL = "alternative_swing_control"
 CONF_ANSWER_TIMEOUT = "answer_timeout"
+CONF_BIG_DATA_INTERVAL = "big_data_interval"
 CONF_CONTROL_METHOD = "control_method"
 CONF_CONTROL_PACKET_SIZE = "control_packet_size"
+CONF_CURRENT_TEMPERATURE_FILTER = "current_temperature_filter"
+CONF_DEADBAND = "deadband"
+CONF_FAST_POLLING_DURATION = "fast_polling_duration"
+CONF_FAST_START = "fast_start"
+CONF_HEARTBEAT = "heartbeat"
 CONF_HORIZONTAL_AIRFLOW = "horizontal_airflow"
+CONF_MAX_INTERVAL = "max_interval"
+CONF_MIN_INTERVAL = "min_interval"
 CONF_ON_ALARM_START = "on_alarm_start"
 CONF_ON_ALARM_END = "on_alarm_end"
 CONF_ON_STATUS_MESSAGE = "on_status_message"
+CONF_PIPELINING = "pipelining"
+CONF_PIPELINING_GAP = "pipelining_gap"
+CONF_FRAME_CAPTURE_SIZE = "frame_capture_size"
+CONF_POLLING_GROUP = "polling_group"
 CONF_SENSORS_PACKET_SIZE = "sensors_packet_size"
 CONF_STATUS_MESSAGE_HEADER_SIZE = "status_message_header_size"
+CONF_STATUS_POLLING = "status_polling"
 CONF_VERTICAL_AIRFLOW = "vertical_airflow"
 CONF_WIFI_SIGNAL = "wifi_signal"
 
@@ -63,6 +79,7 @@ HaierClimateBase = haier_ns.class_(
     "HaierClimateBase", uart.UARTDevice, climate.Climate, cg.Component
 )
 HonClimate = haier_ns.class_("HonClimate", HaierClimateBase)
+PollingGroup = haier_ns.class_("PollingGroup")
 Smartair2Climate = haier_ns.class_("Smartair2Climate", HaierClimateBase)
 
 CONF_HAIER_ID = "haier_id"
@@ -119,6 +136,7 @@ SUPPORTED_HON_CONTROL_METHODS = {
     "MONITOR_ONLY": HonControlMethod.MONITOR_ONLY,
     "SET_GROUP_PARAMETERS": HonControlMethod.SET_GROUP_PARAMETERS,
     "SET_SINGLE_PARAMETER": HonControlMethod.SET_SINGLE_PARAMETER,
+    "AUTO": HonControlMethod.AUTO,
 }
 
 
@@ -166,6 +184,93 @@ def validate_visual(config):
     return config
 
 
+def validate_status_polling(config):
+    min_interval = config[CONF_MIN_INTERVAL]
+    interval = config[CONF_INTERVAL]
+    max_interval = config[CONF_MAX_INTERVAL]
+    if not min_interval <= interval <= max_interval:
+        raise cv.Invalid(
+            f"Status polling intervals should satisfy {CONF_MIN_INTERVAL} <= {CONF_INTERVAL} <= {CONF_MAX_INTERVAL}"
+        )
+    return config
+
+
+STATUS_POLLING_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.Optional(CONF_MIN_INTERVAL, default="500ms"): cv.All(
+                cv.positive_time_period_milliseconds,
+                cv.Range(min=cv.TimePeriod(milliseconds=200)),
+            ),
+            cv.Optional(CONF_INTERVAL, default="5s"): cv.positive_time_period_milliseconds,
+            # Should be much less than communication timeout (60s)
+            cv.Optional(CONF_MAX_INTERVAL, default="30s"): cv.All(
+                cv.positive_time_period_milliseconds,
+                cv.Range(max=cv.TimePeriod(seconds=45)),
+            ),
+            cv.Optional(
+                CONF_FAST_POLLING_DURATION, default="10s"
+            ): cv.positive_time_period_milliseconds,
+        }
+    ),
+    validate_status_polling,
+)
+
+
+def validate_frame_capture_size(value):
+    value = cv.int_range(min=0)(value)
+    # Capture buffer is allocated in RAM once, limit it by the RAM size of the platform
+    if CORE.is_esp8266:
+        max_size = 4096
+    elif CORE.is_libretiny:
+        max_size = 8192
+    elif CORE.is_rp2040:
+        max_size = 16384
+    elif CORE.is_esp32:
+        max_size = 32768
+    else:
+        max_size = 65536
+    if value > max_size:
+        raise cv.Invalid(
+            f"{CONF_FRAME_CAPTURE_SIZE} can't be bigger than {max_size} bytes on this platform"
+        )
+    return value
+
+
+def validate_publish_filter(config):
+    heartbeat = config[CONF_HEARTBEAT]
+    if heartbeat.total_milliseconds and heartbeat < config[CONF_MIN_INTERVAL]:
+        raise cv.Invalid(
+            f"{CONF_HEARTBEAT} should be greater than or equal to {CONF_MIN_INTERVAL}"
+        )
+    return config
+
+
+# Filter that is applied before the value is published, default values publish every change
+PUBLISH_FILTER_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.Optional(CONF_DEADBAND, default=0.0): cv.positive_float,
+            cv.Optional(
+                CONF_MIN_INTERVAL, default="0s"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(
+                CONF_HEARTBEAT, default="0s"
+            ): cv.positive_time_period_milliseconds,
+        }
+    ),
+    validate_publish_filter,
+)
+
+
+def publish_filter_args(config):
+    return (
+        config[CONF_DEADBAND],
+        config[CONF_MIN_INTERVAL],
+        config[CONF_HEARTBEAT],
+    )
+
+
 def _base_config_schema(class_: MockObjClass) -> cv.Schema:
     return (
         climate.climate_schema(class_)
@@ -188,6 +293,15 @@ def _base_config_schema(class_: MockObjClass) -> cv.Schema:
                     CONF_ANSWER_TIMEOUT,
                 ): cv.positive_time_period_milliseconds,
                 cv.Optional(CONF_ON_STATUS_MESSAGE): automation.validate_automation({}),
+                cv.Optional(CONF_POLLING_GROUP): cv.validate_id_name,
+                cv.Optional(CONF_STATUS_POLLING, default={}): STATUS_POLLING_SCHEMA,
+                cv.Optional(CONF_FAST_START, default=False): cv.boolean,
+                cv.Optional(CONF_PIPELINING, default=False): cv.boolean,
+                cv.Optional(
+                    CONF_PIPELINING_GAP, default="50ms"
+                ): cv.positive_time_period_milliseconds,
+                cv.Optional(CONF_CURRENT_TEMPERATURE_FILTER): PUBLISH_FILTER_SCHEMA,
+                cv.Optional(CONF_FRAME_CAPTURE_SIZE): validate_frame_capture_size,
             }
         )
         .extend(uart.UART_DEVICE_SCHEMA)
@@ -216,6 +330,16 @@ CONFIG_SCHEMA = cv.All(
                     cv.Optional(
                         CONF_CONTROL_METHOD, default="SET_GROUP_PARAMETERS"
                     ): cv.enum(SUPPORTED_HON_CONTROL_METHODS, upper=True),
+                    cv.Optional(CONF_BIG_DATA_INTERVAL, default="15s"): cv.All(
+                        cv.positive_time_period_milliseconds,
+                        cv.Range(min=cv.TimePeriod(milliseconds=200)),
+                    ),
+                    cv.Optional(
+                        CONF_ALARM_STATUS_INTERVAL, default="10min"
+                    ): cv.All(
+                        cv.positive_time_period_milliseconds,
+                        cv.Range(min=cv.TimePeriod(seconds=10)),
+                    ),
                     cv.Optional(CONF_BEEPER): cv.invalid(
                         f"The {CONF_BEEPER} option is deprecated, use beeper_on/beeper_off actions or beeper switch for a haier platform instead"
                     ),
@@ -270,6 +394,8 @@ HealthOffAction = haier_ns.class_("HealthOffAction", automation.Action)
 PowerOnAction = haier_ns.class_("PowerOnAction", automation.Action)
 PowerOffAction = haier_ns.class_("PowerOffAction", automation.Action)
 PowerToggleAction = haier_ns.class_("PowerToggleAction", automation.Action)
+DumpFrameCaptureAction = haier_ns.class_("DumpFrameCaptureAction", automation.Action)
+ClearFrameCaptureAction = haier_ns.class_("ClearFrameCaptureAction", automation.Action)
 
 HAIER_BASE_ACTION_SCHEMA = automation.maybe_simple_id(
     {
@@ -424,6 +550,23 @@ async def power_action_to_code(config, action_id, template_arg, args):
     return cg.new_Pvariable(action_id, template_arg, paren)
 
 
+@automation.register_action(
+    "climate.haier.dump_frame_capture",
+    DumpFrameCaptureAction,
+    HAIER_BASE_ACTION_SCHEMA,
+    synchronous=True,
+)
+@automation.register_action(
+    "climate.haier.clear_frame_capture",
+    ClearFrameCaptureAction,
+    HAIER_BASE_ACTION_SCHEMA,
+    synchronous=True,
+)
+async def frame_capture_action_to_code(config, action_id, template_arg, args):
+    paren = await cg.get_variable(config[CONF_ID])
+    return cg.new_Pvariable(action_id, template_arg, paren)
+
+
 def _final_validate(config):
     full_config = fv.full_config.get()
     if CONF_LOGGER in full_config:
@@ -444,6 +587,21 @@ def _final_validate(config):
             "No logger component found, logging for Haier protocol is disabled"
         )
         cg.add_build_flag("-DHAIER_LOG_LEVEL=0")
+    if config.get(CONF_FRAME_CAPTURE_SIZE, 0) > 0:
+        # Capture is dumped to the log with INFO level
+        _level = "NONE"
+        if CONF_LOGGER in full_config:
+            logger_config = full_config[CONF_LOGGER]
+            _level = logger_config.get(CONF_LOGS, {}).get(
+                "haier.climate", logger_config[CONF_LEVEL]
+            )
+        if logger.LOG_LEVEL_SEVERITY.index(
+            _level
+        ) < logger.LOG_LEVEL_SEVERITY.index("INFO"):
+            raise cv.Invalid(
+                f"{CONF_FRAME_CAPTURE_SIZE} requires INFO or more verbose log level for haier.climate, "
+                f"capture can't be dumped with {_level} level"
+            )
     if config.get(CONF_WIFI_SIGNAL) and CONF_WIFI not in full_config:
         raise cv.Invalid(
             f"No WiFi configured, if you want to use haier climate without WiFi add {CONF_WIFI_SIGNAL}: false to climate configuration"
@@ -473,6 +631,16 @@ _CALLBACK_AUTOMATIONS = (
 )
 
 
+def _get_polling_group(name):
+    groups = CORE.data.setdefault("haier_polling_groups", {})
+    if name not in groups:
+        group_id = ID(
+            f"haier_polling_group_{name}", is_declaration=True, type=PollingGroup
+        )
+        groups[name] = cg.new_Pvariable(group_id, name)
+    return groups[name]
+
+
 async def to_code(config):
     cg.add(haier_ns.init_haier_protocol_logging())
     var = await climate.new_climate(config)
@@ -480,8 +648,24 @@ async def to_code(config):
     await uart.register_uart_device(var, config)
 
     cg.add(var.set_send_wifi(config[CONF_WIFI_SIGNAL]))
+    cg.add(var.set_fast_start(config[CONF_FAST_START]))
+    cg.add(
+        var.set_pipelining(config[CONF_PIPELINING], config[CONF_PIPELINING_GAP])
+    )
+    if CONF_FRAME_CAPTURE_SIZE in config:
+        cg.add(var.set_frame_capture_size(config[CONF_FRAME_CAPTURE_SIZE]))
+    if CONF_CURRENT_TEMPERATURE_FILTER in config:
+        cg.add(
+            var.set_current_temperature_filter(
+                *publish_filter_args(config[CONF_CURRENT_TEMPERATURE_FILTER])
+            )
+        )
     if CONF_CONTROL_METHOD in config:
         cg.add(var.set_control_method(config[CONF_CONTROL_METHOD]))
+    if CONF_BIG_DATA_INTERVAL in config:
+        cg.add(var.set_big_data_interval(config[CONF_BIG_DATA_INTERVAL]))
+    if CONF_ALARM_STATUS_INTERVAL in config:
+        cg.add(var.set_alarm_status_interval(config[CONF_ALARM_STATUS_INTERVAL]))
     if CONF_BEEPER in config:
         cg.add(var.set_beeper_state(config[CONF_BEEPER]))
     if CONF_DISPLAY in config:
@@ -514,6 +698,21 @@ async def to_code(config):
         cg.add(
             var.set_status_message_header_size(config[CONF_STATUS_MESSAGE_HEADER_SIZE])
         )
+    if CONF_POLLING_GROUP in config:
+        group = _get_polling_group(config[CONF_POLLING_GROUP])
+        cg.add(var.set_polling_group(group))
+    if CONF_STATUS_POLLING in config:
+        polling_config = config[CONF_STATUS_POLLING]
+        cg.add(
+            var.set_status_polling_intervals(
+                polling_config[CONF_MIN_INTERVAL],
+                polling_config[CONF_INTERVAL],
+                polling_config[CONF_MAX_INTERVAL],
+            )
+        )
+        cg.add(
+            var.set_fast_polling_duration(polling_config[CONF_FAST_POLLING_DURATION])
+        )
     await automation.build_callback_automations(var, config, _CALLBACK_AUTOMATIONS)
     # https://github.com/paveldn/HaierProtocol
     cg.add_library("pavlodn/HaierProtocol", "0.9.31")
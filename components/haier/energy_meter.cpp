@@ -0,0 +1,69 @@
+#include "energy_meter.h"
+
+namespace esphome {
+namespace haier {
+
+// Samples with bigger gap (communication problems, protocol reset) are not integrated
+constexpr uint32_t MAX_SAMPLE_GAP_MS = 300000;
+constexpr uint32_t ENERGY_SAVE_INTERVAL_MS = 600000;
+
+void EnergyMeter::set_preference(size_t slot, ESPPreferenceObject preference) {
+  if (slot < SAVE_SLOTS)
+    this->slots_[slot] = preference;
+}
+
+bool EnergyMeter::restore() {
+  bool restored = false;
+  for (auto &slot : this->slots_) {
+    State stored;
+    if (slot.load(&stored) && ((!restored) || (stored.sequence > this->state_.sequence))) {
+      this->state_ = stored;
+      restored = true;
+    }
+  }
+  this->last_save_time_ = std::chrono::steady_clock::now();
+  return restored;
+}
+
+void EnergyMeter::add_sample(float power_w, std::chrono::steady_clock::time_point now) {
+  if (this->has_sample_) {
+    uint32_t interval_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - this->last_sample_time_).count();
+    if (interval_ms <= MAX_SAMPLE_GAP_MS) {
+      double energy_wh = (this->last_power_w_ + power_w) / 2.0 * interval_ms / 3600000.0;
+      if (energy_wh > 0.0) {
+        this->state_.total_energy_wh += energy_wh;
+        this->state_.daily_energy_wh += energy_wh;
+        this->changed_ = true;
+      }
+    }
+  }
+  this->has_sample_ = true;
+  this->last_power_w_ = power_w;
+  this->last_sample_time_ = now;
+}
+
+void EnergyMeter::set_day(uint32_t day) {
+  if (day == this->state_.day)
+    return;
+  if (this->state_.day != 0)
+    this->state_.daily_energy_wh = 0.0;
+  this->state_.day = day;
+  this->changed_ = true;
+}
+
+void EnergyMeter::save(std::chrono::steady_clock::time_point now, bool force) {
+  if (!this->changed_)
+    return;
+  if (!force && (std::chrono::duration_cast<std::chrono::milliseconds>(now - this->last_save_time_).count() <
+                 ENERGY_SAVE_INTERVAL_MS))
+    return;
+  this->state_.sequence++;
+  if (this->slots_[this->state_.sequence % SAVE_SLOTS].save(&this->state_)) {
+    this->saves_count_++;
+    this->changed_ = false;
+  }
+  this->last_save_time_ = now;
+}
+
+}  // namespace haier
+}  // namespace esphome
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "esphome/core/preferences.h"
+
+namespace esphome {
+namespace haier {
+
+// Integrates AC power samples into energy using trapezoidal rule over the real sample times.
+// Totals are stored in flash periodically, consecutive saves go to different preference slots
+// to spread flash wear.
+class EnergyMeter {
+ public:
+  static constexpr size_t SAVE_SLOTS = 4;
+  struct State {
+    uint32_t sequence;  // Number of the save, the slot with the biggest number is the latest one
+    double total_energy_wh;
+    double daily_energy_wh;
+    uint32_t day;  // Day of the daily energy (year * 1000 + day of year), 0 if unknown
+  };
+  void set_preference(size_t slot, ESPPreferenceObject preference);
+  // Loads the latest saved state, returns false if there is no saved state
+  bool restore();
+  void add_sample(float power_w, std::chrono::steady_clock::time_point now);
+  // Next sample starts new integration interval (no data for the time in between)
+  void reset_samples() { this->has_sample_ = false; };
+  // Resets daily energy if the day changed
+  void set_day(uint32_t day);
+  // Saves the state if it changed and save interval passed (or if forced)
+  void save(std::chrono::steady_clock::time_point now, bool force = false);
+  float get_total_energy_kwh() const { return this->state_.total_energy_wh / 1000.0; };
+  float get_daily_energy_kwh() const { return this->state_.daily_energy_wh / 1000.0; };
+  uint32_t get_saves_count() const { return this->saves_count_; };
+
+ protected:
+  ESPPreferenceObject slots_[SAVE_SLOTS];
+  State state_{0, 0.0, 0.0, 0};
+  bool has_sample_{false};
+  float last_power_w_{0.0f};
+  std::chrono::steady_clock::time_point last_sample_time_;
+  bool changed_{false};
+  std::chrono::steady_clock::time_point last_save_time_;
+  uint32_t saves_count_{0};
+};
+
+}  // namespace haier
+}  // namespace esphome
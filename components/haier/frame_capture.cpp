@@ -0,0 +1,78 @@
+#include <algorithm>
+#include "frame_capture.h"
+
+namespace esphome {
+namespace haier {
+
+constexpr size_t MAX_RECORD_DATA_SIZE = 255;
+
+void FrameCapture::set_buffer_size(size_t size) {
+  // Buffer should be able to keep at least one full record
+  if ((size > 0) && (size < RECORD_HEADER_SIZE + MAX_RECORD_DATA_SIZE))
+    size = RECORD_HEADER_SIZE + MAX_RECORD_DATA_SIZE;
+  this->buffer_.assign(size, 0);
+  this->buffer_.shrink_to_fit();
+  this->clear();
+}
+
+void FrameCapture::add(Direction direction, const uint8_t *data, size_t size, uint32_t timestamp_us) {
+  if (!this->is_enabled())
+    return;
+  // Long chunks are split to records with the same timestamp
+  while (size > 0) {
+    uint8_t record_size = (size > MAX_RECORD_DATA_SIZE) ? MAX_RECORD_DATA_SIZE : size;
+    this->add_record_(direction, data, record_size, timestamp_us);
+    data += record_size;
+    size -= record_size;
+  }
+}
+
+void FrameCapture::clear() {
+  this->head_ = 0;
+  this->used_ = 0;
+  this->records_ = 0;
+  this->dropped_ = 0;
+}
+
+size_t FrameCapture::read_export(size_t offset, uint8_t *out, size_t size) const {
+  size_t export_size = this->get_export_size();
+  if (offset >= export_size)
+    return 0;
+  size = std::min(size, export_size - offset);
+  const uint8_t header[HEADER_SIZE] = {'H', 'C', 'A', 'P', FORMAT_VERSION, 0, 0, 0, (uint8_t) this->dropped_,
+                                       (uint8_t) (this->dropped_ >> 8), (uint8_t) (this->dropped_ >> 16),
+                                       (uint8_t) (this->dropped_ >> 24)};
+  size_t tail = this->head_ + this->buffer_.size() - this->used_;
+  for (size_t i = 0; i < size; i++, offset++)
+    out[i] = (offset < HEADER_SIZE) ? header[offset] : this->get_(tail + offset - HEADER_SIZE);
+  return size;
+}
+
+void FrameCapture::add_record_(Direction direction, const uint8_t *data, uint8_t size, uint32_t timestamp_us) {
+  size_t record_size = RECORD_HEADER_SIZE + size;
+  while (this->used_ + record_size > this->buffer_.size())
+    this->drop_oldest_();
+  for (size_t i = 0; i < 4; i++)
+    this->put_((uint8_t) (timestamp_us >> (8 * i)));
+  this->put_((uint8_t) direction);
+  this->put_(size);
+  for (size_t i = 0; i < size; i++)
+    this->put_(data[i]);
+  this->records_++;
+}
+
+void FrameCapture::drop_oldest_() {
+  size_t tail = this->head_ + this->buffer_.size() - this->used_;
+  this->used_ -= RECORD_HEADER_SIZE + this->get_(tail + RECORD_HEADER_SIZE - 1);
+  this->records_--;
+  this->dropped_++;
+}
+
+void FrameCapture::put_(uint8_t value) {
+  this->buffer_[this->head_] = value;
+  this->head_ = (this->head_ + 1) % this->buffer_.size();
+  this->used_++;
+}
+
+}  // namespace haier
+}  // namespace esphome
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace haier {
+
+// RAM ring of raw UART traffic. Every chunk written to or read from UART is stored as a record with
+// microsecond timestamp and direction, the oldest records are dropped when there is no space left.
+// Capture is taken below the protocol handler, so it also contains frames that were rejected by
+// handlers or broken on the wire.
+//
+// Export format (little endian):
+//   header: "HCAP", uint8 version, uint8 reserved[3], uint32 number of dropped records
+//   record: uint32 timestamp in us (wraps around), uint8 direction, uint8 data size, data
+class FrameCapture {
+ public:
+  enum class Direction : uint8_t {
+    RX = 0,  // From the appliance
+    TX = 1,  // To the appliance
+  };
+  static constexpr uint8_t FORMAT_VERSION = 1;
+  static constexpr size_t HEADER_SIZE = 12;
+  static constexpr size_t RECORD_HEADER_SIZE = 6;
+  // Buffer is allocated once, 0 disables capture
+  void set_buffer_size(size_t size);
+  bool is_enabled() const { return !this->buffer_.empty(); };
+  void add(Direction direction, const uint8_t *data, size_t size, uint32_t timestamp_us);
+  void clear();
+  size_t get_records_count() const { return this->records_; };
+  uint32_t get_dropped_count() const { return this->dropped_; };
+  size_t get_buffer_size() const { return this->buffer_.size(); };
+  // Size of the exported capture
+  size_t get_export_size() const { return HEADER_SIZE + this->used_; };
+  // Copies part of the capture in export format (oldest records first) starting at offset directly from
+  // the ring, returns number of bytes copied (0 after the end of the capture)
+  size_t read_export(size_t offset, uint8_t *out, size_t size) const;
+
+ protected:
+  void add_record_(Direction direction, const uint8_t *data, uint8_t size, uint32_t timestamp_us);
+  void drop_oldest_();
+  void put_(uint8_t value);
+  uint8_t get_(size_t position) const { return this->buffer_[position % this->buffer_.size()]; };
+  std::vector<uint8_t> buffer_;
+  size_t head_{0};  // Position for the next byte
+  size_t used_{0};
+  size_t records_{0};
+  uint32_t dropped_{0};
+};
+
+}  // namespace haier
+}  // namespace esphome
@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <chrono>
+#include <cinttypes>
 #include <string>
 #include "esphome/components/climate/climate.h"
 #include "esphome/components/uart/uart.h"
@@ -16,9 +18,17 @@ namespace haier {
 static const char *const TAG = "haier.climate";
 constexpr size_t COMMUNICATION_TIMEOUT_MS = 60000;
 constexpr size_t STATUS_REQUEST_INTERVAL_MS = 5000;
+constexpr size_t MIN_STATUS_REQUEST_INTERVAL_MS = 500;
+constexpr size_t MAX_STATUS_REQUEST_INTERVAL_MS = 30000;
+constexpr size_t FAST_POLLING_DURATION_MS = 10000;
+constexpr size_t STABLE_STATE_TIMEOUT_MS = 60000;
 constexpr size_t PROTOCOL_INITIALIZATION_INTERVAL = 10000;
+constexpr size_t FAST_START_MESSAGES_INTERVAL_MS = 200;
 constexpr size_t DEFAULT_MESSAGES_INTERVAL_MS = 2000;
 constexpr size_t CONTROL_MESSAGES_INTERVAL_MS = 400;
+constexpr size_t PROTOCOL_SENSORS_UPDATE_INTERVAL_MS = 60000;
+// Multiple of 3 to get base64 lines without padding
+constexpr size_t FRAME_CAPTURE_LOG_CHUNK_SIZE = 96;
 
 const char *HaierClimateBase::phase_to_string_(ProtocolPhases phase) {
   static const char *phase_names[] = {
@@ -33,6 +43,7 @@ const char *HaierClimateBase::phase_to_string_(ProtocolPhases phase) {
       "SENDING_CONTROL",
       "SENDING_ACTION_COMMAND",
       "SENDING_ALARM_STATUS_REQUEST",
+      "SENDING_DEVICE_VERSION_CHECK",
       "UNKNOWN"  // Should be the last!
   };
   static_assert(
@@ -49,6 +60,23 @@ bool check_timeout(std::chrono::steady_clock::time_point now, std::chrono::stead
   return std::chrono::duration_cast<std::chrono::milliseconds>(now - tpoint).count() > timeout;
 }
 
+enum class MergeResult { ADDED, COALESCED, DROPPED };
+
+// Merge requested value into pending settings. Expected AC state is the value that is being sent now
+// or the last state received from AC. Requests that don't change expected state are dropped.
+template<typename T>
+static MergeResult merge_setting(optional<T> &pending, const T &requested, const optional<T> &in_flight,
+                                 const optional<T> &confirmed) {
+  const optional<T> &expected = in_flight.has_value() ? in_flight : confirmed;
+  if (expected.has_value() && (expected.value() == requested)) {
+    pending.reset();
+    return MergeResult::DROPPED;
+  }
+  MergeResult result = pending.has_value() ? MergeResult::COALESCED : MergeResult::ADDED;
+  pending = requested;
+  return result;
+}
+
 HaierClimateBase::HaierClimateBase()
     : haier_protocol_(*this),
       protocol_phase_(ProtocolPhases::SENDING_INIT_1),
@@ -56,7 +84,12 @@ HaierClimateBase::HaierClimateBase()
       forced_request_status_(false),
       reset_protocol_request_(false),
       send_wifi_signal_(true),
-      use_crc_(false) {
+      use_crc_(false),
+      min_status_interval_ms_(MIN_STATUS_REQUEST_INTERVAL_MS),
+      status_interval_ms_(STATUS_REQUEST_INTERVAL_MS),
+      max_status_interval_ms_(MAX_STATUS_REQUEST_INTERVAL_MS),
+      fast_polling_duration_ms_(FAST_POLLING_DURATION_MS),
+      current_status_interval_ms_(STATUS_REQUEST_INTERVAL_MS) {
   this->traits_ = climate::ClimateTraits();
   this->traits_.set_supported_modes({climate::CLIMATE_MODE_OFF, climate::CLIMATE_MODE_COOL, climate::CLIMATE_MODE_HEAT,
                                      climate::CLIMATE_MODE_FAN_ONLY, climate::CLIMATE_MODE_DRY,
@@ -73,6 +106,26 @@ HaierClimateBase::~HaierClimateBase() {}
 void HaierClimateBase::set_phase(ProtocolPhases phase) {
   if (this->protocol_phase_ != phase) {
     ESP_LOGV(TAG, "Phase transition: %s => %s", phase_to_string_(this->protocol_phase_), phase_to_string_(phase));
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if ((this->protocol_phase_ >= ProtocolPhases::SENDING_INIT_1) &&
+        (this->protocol_phase_ < ProtocolPhases::NUM_PROTOCOL_PHASES)) {
+      this->phase_time_ms_[(size_t) this->protocol_phase_] +=
+          std::chrono::duration_cast<std::chrono::milliseconds>(now - this->phase_start_).count();
+    }
+    this->phase_start_ = now;
+    if ((this->protocol_phase_ < ProtocolPhases::IDLE) && (phase >= ProtocolPhases::IDLE)) {
+      this->last_initialization_time_ms_ =
+          std::chrono::duration_cast<std::chrono::milliseconds>(now - this->initialization_start_).count();
+      ESP_LOGI(TAG, "Protocol initialized in %" PRIu32 " ms%s", this->last_initialization_time_ms_,
+               this->fast_start_active_ ? " (fast start)" : "");
+      this->fast_start_active_ = false;
+    }
+    if (this->polling_group_ != nullptr) {
+      if (this->protocol_phase_ == ProtocolPhases::SENDING_STATUS_REQUEST)
+        this->polling_group_->release(this, now);
+      if ((phase != ProtocolPhases::IDLE) && (phase != ProtocolPhases::SENDING_STATUS_REQUEST))
+        this->polling_group_->withdraw(this);
+    }
     this->protocol_phase_ = phase;
   }
 }
@@ -92,21 +145,92 @@ void HaierClimateBase::reset_to_idle_() {
 }
 
 bool HaierClimateBase::is_message_interval_exceeded_(std::chrono::steady_clock::time_point now) {
-  return check_timeout(now, this->last_request_timestamp_, DEFAULT_MESSAGES_INTERVAL_MS);
+  if (this->fast_start_active_)
+    return !this->haier_protocol_.is_waiting_for_answer() &&
+           check_timeout(now, this->last_request_timestamp_, FAST_START_MESSAGES_INTERVAL_MS);
+  if (this->pipelining_)
+    return !this->haier_protocol_.is_waiting_for_answer() &&
+           check_timeout(now, this->last_answer_timestamp_, this->pipelining_gap_ms_);
+  // During fast polling the interval between messages shouldn't be longer than status polling interval
+  return check_timeout(now, this->last_request_timestamp_,
+                       std::min<size_t>(DEFAULT_MESSAGES_INTERVAL_MS, this->current_status_interval_ms_));
 }
 
 bool HaierClimateBase::is_status_request_interval_exceeded_(std::chrono::steady_clock::time_point now) {
-  return check_timeout(now, this->last_status_request_, STATUS_REQUEST_INTERVAL_MS);
+  return check_timeout(now, this->last_status_request_, this->current_status_interval_ms_);
 }
 
 bool HaierClimateBase::is_control_message_interval_exceeded_(std::chrono::steady_clock::time_point now) {
+  if (this->pipelining_)
+    return !this->haier_protocol_.is_waiting_for_answer() &&
+           check_timeout(now, this->last_answer_timestamp_, this->pipelining_gap_ms_);
   return check_timeout(now, this->last_request_timestamp_, CONTROL_MESSAGES_INTERVAL_MS);
 }
 
 bool HaierClimateBase::is_protocol_initialisation_interval_exceeded_(std::chrono::steady_clock::time_point now) {
+  if (this->fast_start_active_)
+    return !this->haier_protocol_.is_waiting_for_answer() &&
+           check_timeout(now, this->last_request_timestamp_, FAST_START_MESSAGES_INTERVAL_MS);
   return check_timeout(now, this->last_request_timestamp_, PROTOCOL_INITIALIZATION_INTERVAL);
 }
 
+void HaierClimateBase::start_protocol_initialization_(std::chrono::steady_clock::time_point now) {
+  this->initialization_start_ = now;
+  this->fast_start_active_ = this->fast_start_;
+  if (this->fast_start_active_ && this->has_cached_device_info_()) {
+    ESP_LOGI(TAG, "Fast start, using known device information");
+    this->set_phase(ProtocolPhases::SENDING_FIRST_STATUS_REQUEST);
+  } else {
+    this->set_phase(ProtocolPhases::SENDING_INIT_1);
+  }
+}
+
+void HaierClimateBase::cancel_fast_start_() {
+  if (this->fast_start_active_) {
+    ESP_LOGI(TAG, "No answer from AC, falling back to regular protocol initialization");
+    this->fast_start_active_ = false;
+  }
+}
+
+bool HaierClimateBase::should_request_status_(std::chrono::steady_clock::time_point now) {
+  if (!this->forced_request_status_ && !this->is_status_request_interval_exceeded_(now))
+    return false;
+  return this->acquire_polling_slot_(now);
+}
+
+bool HaierClimateBase::acquire_polling_slot_(std::chrono::steady_clock::time_point now) {
+  // In polling group status requests are interleaved with other appliances
+  return (this->polling_group_ == nullptr) || this->polling_group_->acquire(this, now);
+}
+
+uint32_t HaierClimateBase::calculate_status_request_interval_(std::chrono::steady_clock::time_point now) const {
+  // Poll fast right after user action or while AC is changing its state
+  if (this->is_transient_state_() ||
+      !check_timeout(now, this->last_control_timestamp_, this->fast_polling_duration_ms_))
+    return this->min_status_interval_ms_;
+  // Nothing is going to change soon if AC is off and stable
+  if ((this->mode == CLIMATE_MODE_OFF) &&
+      check_timeout(now, this->last_state_change_timestamp_, STABLE_STATE_TIMEOUT_MS))
+    return this->max_status_interval_ms_;
+  return this->status_interval_ms_;
+}
+
+void HaierClimateBase::register_status_request_(std::chrono::steady_clock::time_point now) {
+  if (this->status_requests_count_ > 0) {
+    uint32_t period = std::chrono::duration_cast<std::chrono::milliseconds>(now - this->last_status_request_).count();
+    // Exponential moving average with 1/8 weight of the last period
+    this->average_status_period_ms_ =
+        (this->average_status_period_ms_ == 0) ? period : (this->average_status_period_ms_ * 7 + period) / 8;
+  }
+  this->status_requests_count_++;
+  if (this->current_status_interval_ms_ < this->status_interval_ms_) {
+    this->fast_status_requests_count_++;
+  } else if (this->current_status_interval_ms_ > this->status_interval_ms_) {
+    this->slow_status_requests_count_++;
+  }
+  this->last_status_request_ = now;
+}
+
 #ifdef USE_WIFI
 haier_protocol::HaierMessage HaierClimateBase::get_wifi_signal_message_() {
   static uint8_t wifi_status_data[4] = {0x00, 0x00, 0x00, 0x00};
@@ -177,6 +301,15 @@ void HaierClimateBase::set_supported_swing_modes(climate::ClimateSwingModeMask m
     this->traits_.add_supported_swing_mode(climate::CLIMATE_SWING_OFF);
 }
 
+size_t HaierClimateBase::read_array(uint8_t *data, size_t len) noexcept {
+  size_t size = std::min(len, this->available());
+  if ((size == 0) || !esphome::uart::UARTDevice::read_array(data, size))
+    return 0;
+  this->frame_capture_.add(FrameCapture::Direction::RX, data, size, micros());
+  this->protocol_statistics_.data_read(size);
+  return size;
+}
+
 void HaierClimateBase::set_answer_timeout(uint32_t timeout) { this->haier_protocol_.set_answer_timeout(timeout); }
 
 void HaierClimateBase::set_supported_modes(climate::ClimateModeMask modes) {
@@ -193,10 +326,42 @@ void HaierClimateBase::set_supported_presets(climate::ClimatePresetMask presets)
 
 void HaierClimateBase::set_send_wifi(bool send_wifi) { this->send_wifi_signal_ = send_wifi; }
 
+void HaierClimateBase::set_status_polling_intervals(uint32_t min_interval, uint32_t interval, uint32_t max_interval) {
+  this->min_status_interval_ms_ = min_interval;
+  this->status_interval_ms_ = interval;
+  this->max_status_interval_ms_ = max_interval;
+  this->current_status_interval_ms_ = interval;
+}
+
+void HaierClimateBase::set_polling_group(PollingGroup *group) {
+  this->polling_group_ = group;
+  if (group != nullptr)
+    group->register_member(this);
+}
+
 void HaierClimateBase::send_custom_command(const haier_protocol::HaierMessage &message) {
   this->action_request_ = PendingAction({ActionRequest::SEND_CUSTOM_COMMAND, message});
 }
 
+void HaierClimateBase::dump_frame_capture() {
+  if (!this->frame_capture_.is_enabled()) {
+    ESP_LOGW(TAG, "Frame capture is disabled");
+    return;
+  }
+  ESP_LOGI(TAG, "Frame capture begin: %zu bytes, %zu records, %" PRIu32 " dropped",
+           this->frame_capture_.get_export_size(), this->frame_capture_.get_records_count(),
+           this->frame_capture_.get_dropped_count());
+  // Capture is streamed from the ring without a full copy
+  uint8_t chunk[FRAME_CAPTURE_LOG_CHUNK_SIZE];
+  size_t offset = 0;
+  size_t size;
+  while ((size = this->frame_capture_.read_export(offset, chunk, sizeof(chunk))) > 0) {
+    ESP_LOGI(TAG, "Frame capture: %s", base64_encode(chunk, size).c_str());
+    offset += size;
+  }
+  ESP_LOGI(TAG, "Frame capture end");
+}
+
 haier_protocol::HandlerError HaierClimateBase::answer_preprocess_(
     haier_protocol::FrameType request_message_type, haier_protocol::FrameType expected_request_message_type,
     haier_protocol::FrameType answer_message_type, haier_protocol::FrameType expected_answer_message_type,
@@ -208,11 +373,15 @@ haier_protocol::HandlerError HaierClimateBase::answer_preprocess_(
   if ((expected_answer_message_type != haier_protocol::FrameType::UNKNOWN_FRAME_TYPE) &&
       (answer_message_type != expected_answer_message_type))
     result = haier_protocol::HandlerError::UNSUPPORTED_MESSAGE;
+  this->last_answer_timestamp_ = std::chrono::steady_clock::now();
   if (!this->haier_protocol_.is_waiting_for_answer() ||
       ((expected_phase != ProtocolPhases::UNKNOWN) && (expected_phase != this->protocol_phase_)))
     result = haier_protocol::HandlerError::UNEXPECTED_MESSAGE;
   if (answer_message_type == haier_protocol::FrameType::INVALID)
     result = haier_protocol::HandlerError::INVALID_ANSWER;
+  // Rejected answers are not counted in statistics
+  if (result == haier_protocol::HandlerError::HANDLER_OK)
+    this->protocol_statistics_.answer_received(request_message_type, this->last_answer_timestamp_);
   return result;
 }
 
@@ -229,27 +398,86 @@ haier_protocol::HandlerError HaierClimateBase::report_network_status_answer_hand
 haier_protocol::HandlerError HaierClimateBase::timeout_default_handler_(haier_protocol::FrameType request_type) {
   ESP_LOGW(TAG, "Answer timeout for command %02X, phase %s", (uint8_t) request_type,
            phase_to_string_(this->protocol_phase_));
+  this->protocol_statistics_.answer_timeout(request_type);
+  this->last_answer_timestamp_ = std::chrono::steady_clock::now();
   if (this->protocol_phase_ > ProtocolPhases::IDLE) {
     this->set_phase(ProtocolPhases::IDLE);
   } else {
+    this->cancel_fast_start_();
     this->set_phase(ProtocolPhases::SENDING_INIT_1);
   }
   return haier_protocol::HandlerError::HANDLER_OK;
 }
 
 void HaierClimateBase::setup() {
-  // Set timestamp here to give AC time to boot
-  this->last_request_timestamp_ = std::chrono::steady_clock::now();
-  this->set_phase(ProtocolPhases::SENDING_INIT_1);
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  // Set timestamp here to give AC time to boot (fast start doesn't wait for it)
+  this->last_request_timestamp_ = now;
+  this->last_state_change_timestamp_ = now;
+  this->phase_start_ = now;
+  this->last_statistics_publish_ = now;
   this->haier_protocol_.set_default_timeout_handler(
       [this](haier_protocol::FrameType type) { return this->timeout_default_handler_(type); });
   this->set_handlers();
   this->initialization();
+  this->start_protocol_initialization_(now);
 }
 
 void HaierClimateBase::dump_config() {
   LOG_CLIMATE("", "Haier Climate", this);
   ESP_LOGCONFIG(TAG, "  Device communication status: %s", this->valid_connection() ? "established" : "none");
+  ESP_LOGCONFIG(TAG, "  Fast start: %s, last initialization time: %" PRIu32 " ms", this->fast_start_ ? "yes" : "no",
+                this->last_initialization_time_ms_);
+  if (this->pipelining_)
+    ESP_LOGCONFIG(TAG, "  Pipelining: gap after answer %" PRIu32 " ms", this->pipelining_gap_ms_);
+  if (this->frame_capture_.is_enabled()) {
+    ESP_LOGCONFIG(TAG, "  Frame capture: buffer %zu bytes, %zu records, %" PRIu32 " dropped",
+                  this->frame_capture_.get_buffer_size(), this->frame_capture_.get_records_count(),
+                  this->frame_capture_.get_dropped_count());
+  }
+  ESP_LOGCONFIG(TAG,
+                "  Status polling interval: min %" PRIu32 " ms, normal %" PRIu32 " ms, max %" PRIu32
+                " ms, current %" PRIu32 " ms\n"
+                "  Status requests: %" PRIu32 " (fast %" PRIu32 ", slow %" PRIu32 "), average period %" PRIu32 " ms",
+                this->min_status_interval_ms_, this->status_interval_ms_, this->max_status_interval_ms_,
+                this->current_status_interval_ms_, this->status_requests_count_, this->fast_status_requests_count_,
+                this->slow_status_requests_count_, this->average_status_period_ms_);
+  ESP_LOGCONFIG(TAG, "  Control updates: coalesced %" PRIu32 ", dropped %" PRIu32, this->coalesced_control_updates_,
+                this->dropped_control_updates_);
+  ESP_LOGCONFIG(TAG, "  UART reads: %" PRIu32 " calls, %" PRIu32 " bytes", this->protocol_statistics_.get_read_calls(),
+                this->protocol_statistics_.get_bytes_read());
+  ESP_LOGCONFIG(TAG, "  Status processing: %" PRIu32 " messages, avg %" PRIu32 " us, max %" PRIu32 " us",
+                this->protocol_statistics_.get_status_processed_count(),
+                this->protocol_statistics_.get_average_status_processing_time(),
+                this->protocol_statistics_.get_max_status_processing_time());
+  if (!this->current_temperature_filter_.is_default()) {
+    ESP_LOGCONFIG(TAG, "  Current temperature changes not published: %" PRIu32,
+                  this->current_temperature_filter_.get_suppressed_count());
+  }
+  for (size_t i = 0; i < this->protocol_statistics_.get_frame_types_count(); i++) {
+    const ProtocolStatistics::FrameStatistics &stats = this->protocol_statistics_.get_frame_statistics(i);
+    ESP_LOGCONFIG(TAG,
+                  "  Request %02X: sent %" PRIu32 ", answered %" PRIu32 ", timeouts %" PRIu32 ", retries %" PRIu32
+                  "\n"
+                  "    Answer time: min %" PRIu32 " ms, avg %" PRIu32 " ms, max %" PRIu32 " ms\n"
+                  "    Answer time histogram: <50ms %" PRIu32 ", <100ms %" PRIu32 ", <200ms %" PRIu32
+                  ", <500ms %" PRIu32 ", <1s %" PRIu32 ", >=1s %" PRIu32,
+                  (uint8_t) stats.frame_type, stats.requests, stats.answers, stats.timeouts, stats.retries,
+                  stats.min_answer_time_ms, (stats.answers > 0) ? stats.total_answer_time_ms / stats.answers : 0,
+                  stats.max_answer_time_ms, stats.histogram[0], stats.histogram[1], stats.histogram[2],
+                  stats.histogram[3], stats.histogram[4], stats.histogram[5]);
+  }
+  for (size_t i = 0; i < (size_t) ProtocolPhases::NUM_PROTOCOL_PHASES; i++) {
+    if (this->phase_time_ms_[i] > 0)
+      ESP_LOGCONFIG(TAG, "  Time in %s: %" PRIu32 " ms", phase_to_string_((ProtocolPhases) i), this->phase_time_ms_[i]);
+  }
+  if (this->polling_group_ != nullptr) {
+    ESP_LOGCONFIG(TAG,
+                  "  Polling group: %s (%zu members)\n"
+                  "  Polling cycle time: last %" PRIu32 " ms, max %" PRIu32 " ms",
+                  this->polling_group_->get_name(), this->polling_group_->get_members_count(),
+                  this->polling_group_->get_last_cycle_time(), this->polling_group_->get_max_cycle_time());
+  }
 }
 
 void HaierClimateBase::loop() {
@@ -271,6 +499,12 @@ void HaierClimateBase::loop() {
       return;
     }
   };
+  uint32_t status_interval = this->calculate_status_request_interval_(now);
+  if (status_interval != this->current_status_interval_ms_) {
+    ESP_LOGD(TAG, "Status polling interval changed: %" PRIu32 " ms => %" PRIu32 " ms",
+             this->current_status_interval_ms_, status_interval);
+    this->current_status_interval_ms_ = status_interval;
+  }
   if ((!this->haier_protocol_.is_waiting_for_answer()) &&
       ((this->protocol_phase_ == ProtocolPhases::IDLE) ||
        (this->protocol_phase_ == ProtocolPhases::SENDING_STATUS_REQUEST) ||
@@ -280,9 +514,11 @@ void HaierClimateBase::loop() {
     // procedure or waiting for an answer
     if (this->action_request_.has_value() && this->prepare_pending_action()) {
       this->set_phase(ProtocolPhases::SENDING_ACTION_COMMAND);
+      this->last_control_timestamp_ = now;
     } else if (this->next_hvac_settings_.valid || this->force_send_control_) {
       ESP_LOGV(TAG, "Control packet is pending");
       this->set_phase(ProtocolPhases::SENDING_CONTROL);
+      this->last_control_timestamp_ = now;
       if (this->next_hvac_settings_.valid) {
         this->current_hvac_settings_ = this->next_hvac_settings_;
         this->next_hvac_settings_.reset();
@@ -293,6 +529,12 @@ void HaierClimateBase::loop() {
   }
   this->process_phase(now);
   this->haier_protocol_.loop();
+#ifdef USE_SENSOR
+  if (check_timeout(now, this->last_statistics_publish_, PROTOCOL_SENSORS_UPDATE_INTERVAL_MS)) {
+    this->last_statistics_publish_ = now;
+    this->publish_protocol_sensors_();
+  }
+#endif  // USE_SENSOR
 #ifdef USE_SWITCH
   if ((this->display_switch_ != nullptr) && (this->display_switch_->state != this->get_display_state())) {
     this->display_switch_->publish_state(this->get_display_state());
@@ -315,7 +557,8 @@ void HaierClimateBase::process_protocol_reset() {
   this->fan_mode.reset();
   this->preset.reset();
   this->publish_state();
-  this->set_phase(ProtocolPhases::SENDING_INIT_1);
+  this->current_temperature_filter_.reset();
+  this->start_protocol_initialization_(std::chrono::steady_clock::now());
 }
 
 bool HaierClimateBase::prepare_pending_action() {
@@ -369,23 +612,66 @@ void HaierClimateBase::control(const ClimateCall &call) {
     ESP_LOGW(TAG, "Can't send control packet, first poll answer not received");
     return;  // cancel the control, we cant do it without a poll answer.
   }
-  if (this->current_hvac_settings_.valid) {
-    ESP_LOGW(TAG, "New settings come faster then processed!");
-  }
-  {
-    if (call.get_mode().has_value())
-      this->next_hvac_settings_.mode = call.get_mode();
-    if (call.get_fan_mode().has_value())
-      this->next_hvac_settings_.fan_mode = call.get_fan_mode();
-    if (call.get_swing_mode().has_value())
-      this->next_hvac_settings_.swing_mode = call.get_swing_mode();
-    if (call.get_target_temperature().has_value())
-      this->next_hvac_settings_.target_temperature = call.get_target_temperature();
-    if (call.get_preset().has_value())
-      this->next_hvac_settings_.preset = call.get_preset();
-    this->next_hvac_settings_.valid = true;
+  // Settings that are not sent yet are merged, so only the last value of each field is sent
+  // no matter how fast new settings come
+  HvacSettings &pending = this->next_hvac_settings_;
+  const HvacSettings &in_flight = this->current_hvac_settings_;
+  MergeResult results[5];
+  size_t results_count = 0;
+  if (call.get_mode().has_value())
+    results[results_count++] = merge_setting<ClimateMode>(pending.mode, call.get_mode().value(), in_flight.mode,
+                                                          this->mode);
+  if (call.get_fan_mode().has_value())
+    results[results_count++] = merge_setting<ClimateFanMode>(pending.fan_mode, call.get_fan_mode().value(),
+                                                             in_flight.fan_mode, this->fan_mode);
+  if (call.get_swing_mode().has_value())
+    results[results_count++] = merge_setting<ClimateSwingMode>(pending.swing_mode, call.get_swing_mode().value(),
+                                                               in_flight.swing_mode, this->swing_mode);
+  if (call.get_target_temperature().has_value())
+    results[results_count++] =
+        merge_setting<float>(pending.target_temperature, call.get_target_temperature().value(),
+                             in_flight.target_temperature, this->target_temperature);
+  if (call.get_preset().has_value())
+    results[results_count++] = merge_setting<ClimatePreset>(pending.preset, call.get_preset().value(), in_flight.preset,
+                                                            this->preset);
+  for (size_t i = 0; i < results_count; i++) {
+    if (results[i] == MergeResult::COALESCED) {
+      this->coalesced_control_updates_++;
+    } else if (results[i] == MergeResult::DROPPED) {
+      this->dropped_control_updates_++;
+    }
   }
-}
+  pending.valid = pending.mode.has_value() || pending.fan_mode.has_value() || pending.swing_mode.has_value() ||
+                  pending.target_temperature.has_value() || pending.preset.has_value();
+  ESP_LOGD(TAG, "Control settings %s, coalesced %" PRIu32 ", dropped %" PRIu32,
+           pending.valid ? "pending" : "unchanged", this->coalesced_control_updates_, this->dropped_control_updates_);
+}
+
+#ifdef USE_SENSOR
+void HaierClimateBase::set_protocol_sensor(ProtocolSensorType type, sensor::Sensor *sens) {
+  if (type < ProtocolSensorType::PROTOCOL_SENSOR_TYPE_COUNT)
+    this->protocol_sensors_[(size_t) type] = sens;
+}
+
+void HaierClimateBase::publish_protocol_sensors_() {
+  float answer_time = this->protocol_statistics_.pop_period_average_answer_time();
+  sensor::Sensor *answer_time_sensor = this->protocol_sensors_[(size_t) ProtocolSensorType::ANSWER_TIME];
+  if (answer_time_sensor != nullptr)
+    answer_time_sensor->publish_state(answer_time);
+  sensor::Sensor *timeouts_sensor = this->protocol_sensors_[(size_t) ProtocolSensorType::ANSWER_TIMEOUTS];
+  if (timeouts_sensor != nullptr)
+    timeouts_sensor->publish_state(this->protocol_statistics_.get_total_timeouts());
+  sensor::Sensor *retries_sensor = this->protocol_sensors_[(size_t) ProtocolSensorType::MESSAGE_RETRIES];
+  if (retries_sensor != nullptr)
+    retries_sensor->publish_state(this->protocol_statistics_.get_total_retries());
+  sensor::Sensor *coalesced_sensor = this->protocol_sensors_[(size_t) ProtocolSensorType::COALESCED_CONTROL_UPDATES];
+  if (coalesced_sensor != nullptr)
+    coalesced_sensor->publish_state(this->coalesced_control_updates_);
+  sensor::Sensor *dropped_sensor = this->protocol_sensors_[(size_t) ProtocolSensorType::DROPPED_CONTROL_UPDATES];
+  if (dropped_sensor != nullptr)
+    dropped_sensor->publish_state(this->dropped_control_updates_);
+}
+#endif  // USE_SENSOR
 
 #ifdef USE_SWITCH
 void HaierClimateBase::set_display_switch(switch_::Switch *sw) {
@@ -412,10 +698,25 @@ void HaierClimateBase::HvacSettings::reset() {
   this->preset.reset();
 }
 
+void HaierClimateBase::HvacSettings::merge(const HvacSettings &newer) {
+  if (newer.mode.has_value())
+    this->mode = newer.mode;
+  if (newer.fan_mode.has_value())
+    this->fan_mode = newer.fan_mode;
+  if (newer.swing_mode.has_value())
+    this->swing_mode = newer.swing_mode;
+  if (newer.target_temperature.has_value())
+    this->target_temperature = newer.target_temperature;
+  if (newer.preset.has_value())
+    this->preset = newer.preset;
+  this->valid = this->valid || newer.valid;
+}
+
 void HaierClimateBase::send_message_(const haier_protocol::HaierMessage &command, bool use_crc, uint8_t num_repeats,
                                      std::chrono::milliseconds interval) {
   this->haier_protocol_.send_message(command, use_crc, num_repeats, interval);
   this->last_request_timestamp_ = std::chrono::steady_clock::now();
+  this->protocol_statistics_.request_queued(command.get_frame_type(), this->last_request_timestamp_);
 }
 
 }  // namespace haier
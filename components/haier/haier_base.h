@@ -4,9 +4,17 @@
 #include "esphome/components/climate/climate.h"
 #include "esphome/components/uart/uart.h"
 #include "esphome/core/automation.h"
+#include "esphome/core/hal.h"
+#include "frame_capture.h"
+#include "polling_group.h"
+#include "protocol_statistics.h"
+#include "publish_filter.h"
 // HaierProtocol
 #include <protocol/haier_protocol.h>
 
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
 #ifdef USE_SWITCH
 #include "esphome/components/switch/switch.h"
 #endif
@@ -14,6 +22,9 @@
 namespace esphome {
 namespace haier {
 
+// Maximal size of the control part of status message (see control_packet_size configuration option)
+constexpr size_t MAX_CONTROL_PACKET_SIZE = 50;
+
 enum class ActionRequest : uint8_t {
   SEND_CUSTOM_COMMAND = 0,
   TURN_POWER_ON = 1,
@@ -32,6 +43,22 @@ class HaierClimateBase : public esphome::Component,
                          public esphome::climate::Climate,
                          public esphome::uart::UARTDevice,
                          public haier_protocol::ProtocolStream {
+#ifdef USE_SENSOR
+ public:
+  enum class ProtocolSensorType {
+    ANSWER_TIME = 0,
+    ANSWER_TIMEOUTS,
+    MESSAGE_RETRIES,
+    COALESCED_CONTROL_UPDATES,
+    DROPPED_CONTROL_UPDATES,
+    PROTOCOL_SENSOR_TYPE_COUNT,
+  };
+  void set_protocol_sensor(ProtocolSensorType type, sensor::Sensor *sens);
+
+ protected:
+  void publish_protocol_sensors_();
+  sensor::Sensor *protocol_sensors_[(size_t) ProtocolSensorType::PROTOCOL_SENSOR_TYPE_COUNT]{nullptr};
+#endif
 #ifdef USE_SWITCH
  public:
   void set_display_switch(switch_::Switch *sw);
@@ -64,16 +91,37 @@ class HaierClimateBase : public esphome::Component,
   void set_supported_presets(esphome::climate::ClimatePresetMask presets);
   bool valid_connection() const { return this->protocol_phase_ >= ProtocolPhases::IDLE; };
   size_t available() noexcept override { return esphome::uart::UARTDevice::available(); };
-  size_t read_array(uint8_t *data, size_t len) noexcept override {
-    return esphome::uart::UARTDevice::read_array(data, len) ? len : 0;
-  };
+  // Reads everything that is available (up to len), doesn't fail if less data than requested has arrived
+  size_t read_array(uint8_t *data, size_t len) noexcept override;
   void write_array(const uint8_t *data, size_t len) noexcept override {
     esphome::uart::UARTDevice::write_array(data, len);
+    this->frame_capture_.add(FrameCapture::Direction::TX, data, len, micros());
+    this->protocol_statistics_.frame_written(data, len, std::chrono::steady_clock::now());
   };
   bool can_send_message() const { return haier_protocol_.get_outgoing_queue_size() == 0; };
   void set_answer_timeout(uint32_t timeout);
   void set_send_wifi(bool send_wifi);
+  void set_polling_group(PollingGroup *group);
+  void set_status_polling_intervals(uint32_t min_interval, uint32_t interval, uint32_t max_interval);
+  void set_fast_polling_duration(uint32_t duration) { this->fast_polling_duration_ms_ = duration; };
+  void set_fast_start(bool fast_start) { this->fast_start_ = fast_start; };
+  // Pipelining: send next request as soon as the previous one is answered (after gap) instead of
+  // waiting fixed intervals counted from the previous request
+  void set_pipelining(bool pipelining, uint32_t gap_ms) {
+    this->pipelining_ = pipelining;
+    this->pipelining_gap_ms_ = gap_ms;
+  };
+  void set_current_temperature_filter(float deadband, uint32_t min_interval_ms, uint32_t heartbeat_ms) {
+    this->current_temperature_filter_.set_parameters(deadband, min_interval_ms, heartbeat_ms);
+  };
   void send_custom_command(const haier_protocol::HaierMessage &message);
+  // Raw UART traffic capture, 0 - disabled
+  void set_frame_capture_size(size_t size) { this->frame_capture_.set_buffer_size(size); };
+  const FrameCapture &get_frame_capture() const { return this->frame_capture_; };
+  const ProtocolStatistics &get_protocol_statistics() const { return this->protocol_statistics_; };
+  // Writes captured traffic to log in export format encoded with base64
+  void dump_frame_capture();
+  void clear_frame_capture() { this->frame_capture_.clear(); };
   template<typename F> void add_status_message_callback(F &&callback) {
     this->status_message_callback_.add(std::forward<F>(callback));
   }
@@ -94,6 +142,7 @@ class HaierClimateBase : public esphome::Component,
     SENDING_CONTROL,
     SENDING_ACTION_COMMAND,
     SENDING_ALARM_STATUS_REQUEST,
+    SENDING_DEVICE_VERSION_CHECK,
     NUM_PROTOCOL_PHASES
   };
   const char *phase_to_string_(ProtocolPhases phase);
@@ -127,6 +176,18 @@ class HaierClimateBase : public esphome::Component,
   bool is_status_request_interval_exceeded_(std::chrono::steady_clock::time_point now);
   bool is_control_message_interval_exceeded_(std::chrono::steady_clock::time_point now);
   bool is_protocol_initialisation_interval_exceeded_(std::chrono::steady_clock::time_point now);
+  // Fast start: probe AC right away, skip handshake if device information is known and send init requests
+  // without pauses. Regular initialization is used if AC doesn't answer.
+  void start_protocol_initialization_(std::chrono::steady_clock::time_point now);
+  void cancel_fast_start_();
+  virtual bool has_cached_device_info_() const { return false; };
+  bool should_request_status_(std::chrono::steady_clock::time_point now);
+  bool acquire_polling_slot_(std::chrono::steady_clock::time_point now);
+  // Adaptive status polling
+  uint32_t calculate_status_request_interval_(std::chrono::steady_clock::time_point now) const;
+  void register_status_request_(std::chrono::steady_clock::time_point now);
+  // Appliance is changing its state by itself (compressor ramping, cleaning, etc.), poll it faster
+  virtual bool is_transient_state_() const { return false; }
 #ifdef USE_WIFI
   haier_protocol::HaierMessage get_wifi_signal_message_();
 #endif
@@ -142,6 +203,8 @@ class HaierClimateBase : public esphome::Component,
     HvacSettings(const HvacSettings &) = default;
     HvacSettings &operator=(const HvacSettings &) = default;
     void reset();
+    // Fields that are set in newer settings replace the current ones
+    void merge(const HvacSettings &newer);
   };
   struct PendingAction {
     ActionRequest action;
@@ -168,12 +231,40 @@ class HaierClimateBase : public esphome::Component,
   esphome::climate::ClimateTraits traits_;
   HvacSettings current_hvac_settings_;
   HvacSettings next_hvac_settings_;
-  std::unique_ptr<uint8_t[]> last_status_message_{nullptr};
+  uint32_t coalesced_control_updates_{0};  // Settings replaced before they were sent
+  uint32_t dropped_control_updates_{0};    // Settings that don't change AC state
+  uint8_t last_status_message_[MAX_CONTROL_PACKET_SIZE]{0};  // Control packet of the last status message
+  size_t last_status_message_size_{0};                           // 0 if there was no status message yet
   std::chrono::steady_clock::time_point last_request_timestamp_;       // For interval between messages
+  std::chrono::steady_clock::time_point last_answer_timestamp_;        // For gap between pipelined messages
   std::chrono::steady_clock::time_point last_valid_status_timestamp_;  // For protocol timeout
   std::chrono::steady_clock::time_point last_status_request_;          // To request AC status
   std::chrono::steady_clock::time_point last_signal_request_;          // To send WiFI signal level
+  std::chrono::steady_clock::time_point last_control_timestamp_;       // For fast polling after control
+  std::chrono::steady_clock::time_point last_state_change_timestamp_;  // For slow polling when AC is stable
+  uint32_t min_status_interval_ms_;
+  uint32_t status_interval_ms_;
+  uint32_t max_status_interval_ms_;
+  uint32_t fast_polling_duration_ms_;
+  uint32_t current_status_interval_ms_;
+  uint32_t status_requests_count_{0};
+  uint32_t fast_status_requests_count_{0};
+  uint32_t slow_status_requests_count_{0};
+  uint32_t average_status_period_ms_{0};
   CallbackManager<void(const char *, size_t)> status_message_callback_{};
+  PollingGroup *polling_group_{nullptr};
+  ProtocolStatistics protocol_statistics_;
+  FrameCapture frame_capture_;
+  PublishFilter current_temperature_filter_;
+  uint32_t phase_time_ms_[(size_t) ProtocolPhases::NUM_PROTOCOL_PHASES]{0};
+  std::chrono::steady_clock::time_point phase_start_;
+  std::chrono::steady_clock::time_point last_statistics_publish_;
+  bool pipelining_{false};
+  uint32_t pipelining_gap_ms_{50};
+  bool fast_start_{false};
+  bool fast_start_active_{false};
+  std::chrono::steady_clock::time_point initialization_start_;
+  uint32_t last_initialization_time_ms_{0};
   ESPPreferenceObject base_rtc_;
 };
 
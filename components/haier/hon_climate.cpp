@@ -1,4 +1,5 @@
 #include <chrono>
+#include <cinttypes>
 #include <string>
 #include "esphome/components/climate/climate.h"
 #include "esphome/components/uart/uart.h"
@@ -17,9 +18,34 @@ constexpr size_t SIGNAL_LEVEL_UPDATE_INTERVAL_MS = 10000;
 constexpr int PROTOCOL_OUTDOOR_TEMPERATURE_OFFSET = -64;
 constexpr uint8_t CONTROL_MESSAGE_RETRIES = 5;
 constexpr std::chrono::milliseconds CONTROL_MESSAGE_RETRIES_INTERVAL = std::chrono::milliseconds(500);
-constexpr size_t ALARM_STATUS_REQUEST_INTERVAL_MS = 600000;
 const uint8_t ONE_BUF[] = {0x00, 0x01};
 const uint8_t ZERO_BUF[] = {0x00, 0x00};
+// Frame bytes without data: separator, length, flags, reserved bytes, frame type, checksum and CRC
+constexpr size_t FRAME_OVERHEAD_SIZE = 13;
+
+// Control packet fields that can be changed with SET_SINGLE_PARAMETER command (same order as in
+// fill_control_messages_queue_) and their location in HaierPacketControl.
+struct SingleParameterField {
+  hon_protocol::DataParameters parameter;
+  PacketField field;
+};
+constexpr SingleParameterField SINGLE_PARAMETER_FIELDS[] = {
+    {hon_protocol::DataParameters::BEEPER_STATUS, hon_protocol::control_fields::BEEPER_STATUS},
+    {hon_protocol::DataParameters::HEALTH_MODE, hon_protocol::control_fields::HEALTH_MODE},
+    {hon_protocol::DataParameters::AC_MODE, hon_protocol::control_fields::AC_MODE},
+    {hon_protocol::DataParameters::AC_POWER, hon_protocol::control_fields::AC_POWER},
+    {hon_protocol::DataParameters::QUIET_MODE, hon_protocol::control_fields::QUIET_MODE},
+    {hon_protocol::DataParameters::FAST_MODE, hon_protocol::control_fields::FAST_MODE},
+    {hon_protocol::DataParameters::TEN_DEGREE, hon_protocol::control_fields::TEN_DEGREE},
+    {hon_protocol::DataParameters::SET_POINT, hon_protocol::control_fields::SET_POINT},
+    {hon_protocol::DataParameters::HORIZONTAL_SWING_MODE, hon_protocol::control_fields::HORIZONTAL_SWING_MODE},
+    {hon_protocol::DataParameters::VERTICAL_SWING_MODE, hon_protocol::control_fields::VERTICAL_SWING_MODE},
+    {hon_protocol::DataParameters::FAN_MODE, hon_protocol::control_fields::FAN_MODE},
+    {hon_protocol::DataParameters::DISPLAY_STATUS, hon_protocol::control_fields::DISPLAY_STATUS},
+    {hon_protocol::DataParameters::USE_FAHRENHEIT, hon_protocol::control_fields::USE_FAHRENHEIT},
+    {hon_protocol::DataParameters::SLEEP_MODE, hon_protocol::control_fields::SLEEP_MODE},
+    {hon_protocol::DataParameters::LOCK_REMOTE, hon_protocol::control_fields::LOCK_REMOTE},
+};
 
 HonClimate::HonClimate()
     : cleaning_status_(CleaningState::NO_CLEANING), got_valid_outdoor_temp_(false), active_alarms_{0x00, 0x00, 0x00,
@@ -85,7 +111,7 @@ void HonClimate::set_horizontal_airflow(hon_protocol::HorizontalSwingMode direct
   this->force_send_control_ = true;
 }
 
-std::string HonClimate::get_cleaning_status_text() const {
+const char *HonClimate::get_cleaning_status_text() const {
   switch (this->cleaning_status_) {
     case CleaningState::SELF_CLEAN:
       return "Self clean";
@@ -117,7 +143,12 @@ void HonClimate::start_steri_cleaning() {
 haier_protocol::HandlerError HonClimate::get_device_version_answer_handler_(haier_protocol::FrameType request_type,
                                                                             haier_protocol::FrameType message_type,
                                                                             const uint8_t *data, size_t data_size) {
+  bool identity_check = this->protocol_phase_ == ProtocolPhases::SENDING_DEVICE_VERSION_CHECK;
   // Should check this before preprocess
+  if (identity_check && (message_type == haier_protocol::FrameType::INVALID)) {
+    this->set_phase(ProtocolPhases::IDLE);
+    return haier_protocol::HandlerError::INVALID_ANSWER;
+  }
   if (message_type == haier_protocol::FrameType::INVALID) {
     ESP_LOGW(TAG, "It looks like your ESPHome Haier climate configuration is wrong. You should use the smartAir2 "
                   "protocol instead of hOn");
@@ -126,41 +157,51 @@ haier_protocol::HandlerError HonClimate::get_device_version_answer_handler_(haie
   }
   haier_protocol::HandlerError result =
       this->answer_preprocess_(request_type, haier_protocol::FrameType::GET_DEVICE_VERSION, message_type,
-                               haier_protocol::FrameType::GET_DEVICE_VERSION_RESPONSE, ProtocolPhases::SENDING_INIT_1);
+                               haier_protocol::FrameType::GET_DEVICE_VERSION_RESPONSE,
+                               identity_check ? ProtocolPhases::SENDING_DEVICE_VERSION_CHECK
+                                              : ProtocolPhases::SENDING_INIT_1);
+  this->device_info_check_pending_ = false;
   if (result == haier_protocol::HandlerError::HANDLER_OK) {
     if (data_size < sizeof(hon_protocol::DeviceVersionAnswer)) {
       // Wrong structure
+      if (identity_check)
+        this->set_phase(ProtocolPhases::IDLE);
       return haier_protocol::HandlerError::WRONG_MESSAGE_STRUCTURE;
     }
     // All OK
     hon_protocol::DeviceVersionAnswer *answr = (hon_protocol::DeviceVersionAnswer *) data;
-    char tmp[9];
-    tmp[8] = 0;
-    strncpy(tmp, answr->protocol_version, 8);
-    this->hvac_hardware_info_ = HardwareInfo();
-    this->hvac_hardware_info_.value().protocol_version_ = std::string(tmp);
-    strncpy(tmp, answr->software_version, 8);
-    this->hvac_hardware_info_.value().software_version_ = std::string(tmp);
-    strncpy(tmp, answr->hardware_version, 8);
-    this->hvac_hardware_info_.value().hardware_version_ = std::string(tmp);
-    strncpy(tmp, answr->device_name, 8);
-    this->hvac_hardware_info_.value().device_name_ = std::string(tmp);
-#ifdef USE_TEXT_SENSOR
-    this->update_sub_text_sensor_(SubTextSensorType::APPLIANCE_NAME, this->hvac_hardware_info_.value().device_name_);
-    this->update_sub_text_sensor_(SubTextSensorType::PROTOCOL_VERSION,
-                                  this->hvac_hardware_info_.value().protocol_version_);
-#endif
-    this->hvac_hardware_info_.value().functions_[0] = (answr->functions[1] & 0x01) != 0;  // interactive mode support
-    this->hvac_hardware_info_.value().functions_[1] =
-        (answr->functions[1] & 0x02) != 0;  // controller-device mode support
-    this->hvac_hardware_info_.value().functions_[2] = (answr->functions[1] & 0x04) != 0;  // crc support
-    this->hvac_hardware_info_.value().functions_[3] = (answr->functions[1] & 0x08) != 0;  // multiple AC support
-    this->hvac_hardware_info_.value().functions_[4] = (answr->functions[1] & 0x20) != 0;  // roles support
-    this->use_crc_ = this->hvac_hardware_info_.value().functions_[2];
+    HonDeviceInfo info{};
+    info.valid = true;
+    memcpy(info.protocol_version, answr->protocol_version, sizeof(info.protocol_version));
+    memcpy(info.software_version, answr->software_version, sizeof(info.software_version));
+    memcpy(info.hardware_version, answr->hardware_version, sizeof(info.hardware_version));
+    memcpy(info.device_name, answr->device_name, sizeof(info.device_name));
+    info.functions = answr->functions[1];
+    info.control_packet_size = sizeof(hon_protocol::HaierPacketControl) + this->extra_control_packet_bytes_;
+    info.sensors_packet_size = sizeof(hon_protocol::HaierPacketSensors) + this->extra_sensors_packet_bytes_;
+    info.status_message_header_size = this->status_message_header_size_;
+    // Identity is everything before the last known control packet
+    if (memcmp(&info, &this->device_info_, offsetof(HonDeviceInfo, control_packet_stored)) != 0) {
+      if (this->device_info_.valid)
+        ESP_LOGI(TAG, "Device identity changed, stored device information is invalidated");
+      this->device_info_ = info;
+      if (this->fast_start_)
+        this->device_info_rtc_.save(&this->device_info_);
+    } else if (identity_check) {
+      ESP_LOGD(TAG, "Stored device information matches AC");
+      this->set_phase(ProtocolPhases::IDLE);
+      return result;
+    }
+    this->apply_device_info_();
+    // Different AC after a warm restart goes through the rest of the regular handshake
     this->set_phase(ProtocolPhases::SENDING_INIT_2);
     return result;
   } else {
-    this->reset_phase_();
+    if (identity_check) {
+      this->set_phase(ProtocolPhases::IDLE);
+    } else {
+      this->reset_phase_();
+    }
     return result;
   }
 }
@@ -187,22 +228,29 @@ haier_protocol::HandlerError HonClimate::status_handler_(haier_protocol::FrameTy
       this->answer_preprocess_(request_type, haier_protocol::FrameType::CONTROL, message_type,
                                haier_protocol::FrameType::STATUS, ProtocolPhases::UNKNOWN);
   if (result == haier_protocol::HandlerError::HANDLER_OK) {
+    uint32_t start_us = micros();
     result = this->process_status_message_(data, data_size);
+    this->protocol_statistics_.status_processed(micros() - start_us);
     if (result != haier_protocol::HandlerError::HANDLER_OK) {
       ESP_LOGW(TAG, "Error %d while parsing Status packet", (int) result);
+      if (this->fast_start_active_ && this->device_info_.valid) {
+        // Stored information doesn't match the appliance
+        this->invalidate_device_info_();
+        this->cancel_fast_start_();
+      }
       this->reset_phase_();
       this->action_request_.reset();
       this->force_send_control_ = false;
     } else {
-      if (!this->last_status_message_) {
+      if (this->last_status_message_size_ == 0) {
         this->real_control_packet_size_ = sizeof(hon_protocol::HaierPacketControl) + this->extra_control_packet_bytes_;
         this->real_sensors_packet_size_ = sizeof(hon_protocol::HaierPacketSensors) + this->extra_sensors_packet_bytes_;
-        this->last_status_message_.reset();
-        this->last_status_message_ = std::unique_ptr<uint8_t[]>(new uint8_t[this->real_control_packet_size_]);
       };
       if (data_size >= this->real_control_packet_size_ + 2) {
-        memcpy(this->last_status_message_.get(), data + 2 + this->status_message_header_size_,
+        memcpy(this->last_status_message_, data + 2 + this->status_message_header_size_,
                this->real_control_packet_size_);
+        this->last_status_message_size_ = this->real_control_packet_size_;
+        this->store_control_packet_(this->last_status_message_);
         this->status_message_callback_.call((const char *) data, data_size);
       } else {
         ESP_LOGW(TAG, "Status packet too small: %zu (should be >= %zu)", data_size, this->real_control_packet_size_);
@@ -219,9 +267,8 @@ haier_protocol::HandlerError HonClimate::status_handler_(haier_protocol::FrameTy
           this->set_phase(ProtocolPhases::IDLE);
           break;
         case ProtocolPhases::SENDING_CONTROL:
-          if (!this->control_messages_queue_.empty())
-            this->control_messages_queue_.pop();
-          if (this->control_messages_queue_.empty()) {
+          this->control_queue_.pop();
+          if (this->control_queue_.empty()) {
             this->set_phase(ProtocolPhases::IDLE);
             this->force_send_control_ = false;
             if (this->current_hvac_settings_.valid)
@@ -261,6 +308,8 @@ haier_protocol::HandlerError HonClimate::get_management_information_answer_handl
 haier_protocol::HandlerError HonClimate::get_alarm_status_answer_handler_(haier_protocol::FrameType request_type,
                                                                           haier_protocol::FrameType message_type,
                                                                           const uint8_t *data, size_t data_size) {
+  // Doesn't use answer_preprocess_ because two phases are valid, pipelining gap still counts from this answer
+  this->last_answer_timestamp_ = std::chrono::steady_clock::now();
   if (request_type == haier_protocol::FrameType::GET_ALARM_STATUS) {
     if (message_type != haier_protocol::FrameType::GET_ALARM_STATUS_RESPONSE) {
       // Unexpected answer to request
@@ -277,6 +326,7 @@ haier_protocol::HandlerError HonClimate::get_alarm_status_answer_handler_(haier_
       return haier_protocol::HandlerError::WRONG_MESSAGE_STRUCTURE;
     this->process_alarm_message_(data, data_size, this->protocol_phase_ >= ProtocolPhases::IDLE);
     this->set_phase(ProtocolPhases::IDLE);
+    this->protocol_statistics_.answer_received(request_type, this->last_answer_timestamp_);
     return haier_protocol::HandlerError::HANDLER_OK;
   } else {
     this->set_phase(ProtocolPhases::IDLE);
@@ -339,18 +389,19 @@ void HonClimate::dump_config() {
   HaierClimateBase::dump_config();
   ESP_LOGCONFIG(TAG,
                 "  Protocol version: hOn\n"
-                "  Control method: %d",
-                (uint8_t) this->control_method_);
+                "  Control method: %d\n"
+                "  Stored device information: %s",
+                (uint8_t) this->control_method_, this->device_info_.valid ? "yes" : "no");
   if (this->hvac_hardware_info_.has_value()) {
     ESP_LOGCONFIG(TAG,
                   "  Device protocol version: %s\n"
                   "  Device software version: %s\n"
                   "  Device hardware version: %s\n"
                   "  Device name: %s",
-                  this->hvac_hardware_info_.value().protocol_version_.c_str(),
-                  this->hvac_hardware_info_.value().software_version_.c_str(),
-                  this->hvac_hardware_info_.value().hardware_version_.c_str(),
-                  this->hvac_hardware_info_.value().device_name_.c_str());
+                  this->hvac_hardware_info_.value().protocol_version_,
+                  this->hvac_hardware_info_.value().software_version_,
+                  this->hvac_hardware_info_.value().hardware_version_,
+                  this->hvac_hardware_info_.value().device_name_);
     ESP_LOGCONFIG(TAG, "  Device features:%s%s%s%s%s",
                   (this->hvac_hardware_info_.value().functions_[0] ? " interactive" : ""),
                   (this->hvac_hardware_info_.value().functions_[1] ? " controller-device" : ""),
@@ -359,6 +410,42 @@ void HonClimate::dump_config() {
                   (this->hvac_hardware_info_.value().functions_[4] ? " role" : ""));
     ESP_LOGCONFIG(TAG, "  Active alarms: %s", buf_to_hex(this->active_alarms_, sizeof(this->active_alarms_)).c_str());
   }
+  ESP_LOGCONFIG(TAG,
+                "  Big data polling interval: %" PRIu32 " ms (%s), requests: %" PRIu32 "\n"
+                "  Alarm status polling interval: %" PRIu32 " ms",
+                this->big_data_interval_ms_, (this->big_data_sensors_ > 0) ? "enabled" : "no big data sensors",
+                this->big_data_requests_count_, this->alarm_status_interval_ms_);
+  ESP_LOGCONFIG(TAG, "  Coalesced control commands: %" PRIu32, this->control_queue_.get_coalesced_count());
+#ifdef USE_SENSOR
+  uint32_t suppressed_sensor_values = 0;
+  for (const auto &filter : this->sub_sensor_filters_)
+    suppressed_sensor_values += filter.get_suppressed_count();
+  ESP_LOGCONFIG(TAG, "  Sensor changes not published: %" PRIu32, suppressed_sensor_values);
+  if (this->is_energy_metering_enabled_()) {
+    ESP_LOGCONFIG(TAG, "  Energy: total %.3f kWh, daily %.3f kWh, saved %" PRIu32 " times",
+                  this->energy_meter_.get_total_energy_kwh(), this->energy_meter_.get_daily_energy_kwh(),
+                  this->energy_meter_.get_saves_count());
+  }
+#endif  // USE_SENSOR
+#ifdef USE_TEXT_SENSOR
+  if (this->is_alarm_history_enabled_()) {
+    ESP_LOGCONFIG(TAG, "  Alarm history: %u events, boot %u, saved %" PRIu32 " times",
+                  (unsigned) this->alarm_history_.size(), this->alarm_history_.get_boot(),
+                  this->alarm_history_.get_saves_count());
+    char message_buffer[hon_protocol::HON_ALARM_MESSAGE_SIZE];
+    for (uint8_t code = 0; code < AlarmHistory::ALARM_CODES; code++) {
+      if (this->alarm_history_.get_occurrences(code) > 0) {
+        ESP_LOGCONFIG(TAG, "    Alarm %u (%s): %u times, active %" PRIu32 " s", code,
+                      hon_protocol::get_alarm_message(code, message_buffer), this->alarm_history_.get_occurrences(code),
+                      this->alarm_history_.get_active_seconds(code));
+      }
+    }
+  }
+#endif  // USE_TEXT_SENSOR
+  if (this->control_method_ == HonControlMethod::AUTO) {
+    ESP_LOGCONFIG(TAG, "  Auto control method: group parameters %" PRIu32 ", single parameters %" PRIu32,
+                  this->auto_group_controls_, this->auto_single_controls_);
+  }
 }
 
 void HonClimate::process_phase(std::chrono::steady_clock::time_point now) {
@@ -377,6 +464,16 @@ void HonClimate::process_phase(std::chrono::steady_clock::time_point now) {
         this->send_message_(DEVICE_VERSION_REQUEST, this->use_crc_);
       }
       break;
+    case ProtocolPhases::SENDING_DEVICE_VERSION_CHECK:
+      if (this->can_send_message() && this->is_message_interval_exceeded_(now)) {
+        uint8_t module_capabilities[2] = {0b00000000, 0b00000111};
+        static const haier_protocol::HaierMessage DEVICE_VERSION_REQUEST(
+            haier_protocol::FrameType::GET_DEVICE_VERSION, module_capabilities, sizeof(module_capabilities));
+        // Only one attempt, the check is skipped if AC doesn't answer
+        this->device_info_check_pending_ = false;
+        this->send_message_(DEVICE_VERSION_REQUEST, this->use_crc_);
+      }
+      break;
     case ProtocolPhases::SENDING_INIT_2:
       if (this->can_send_message() && this->is_message_interval_exceeded_(now)) {
         static const haier_protocol::HaierMessage DEVICEID_REQUEST(haier_protocol::FrameType::GET_DEVICE_ID);
@@ -390,13 +487,16 @@ void HonClimate::process_phase(std::chrono::steady_clock::time_point now) {
             haier_protocol::FrameType::CONTROL, (uint16_t) hon_protocol::SubcommandsControl::GET_USER_DATA);
         static const haier_protocol::HaierMessage BIG_DATA_REQUEST(
             haier_protocol::FrameType::CONTROL, (uint16_t) hon_protocol::SubcommandsControl::GET_BIG_DATA);
+        // Big data answer contains user data too, so it replaces the status request when it is due
         if ((this->protocol_phase_ == ProtocolPhases::SENDING_FIRST_STATUS_REQUEST) ||
-            (!this->should_get_big_data_())) {
+            (!this->is_big_data_request_due_(now))) {
           this->send_message_(STATUS_REQUEST, this->use_crc_);
         } else {
           this->send_message_(BIG_DATA_REQUEST, this->use_crc_);
+          this->last_big_data_request_ = now;
+          this->big_data_requests_count_++;
         }
-        this->last_status_request_ = now;
+        this->register_status_request_(now);
       }
       break;
 #ifdef USE_WIFI
@@ -428,15 +528,29 @@ void HonClimate::process_phase(std::chrono::steady_clock::time_point now) {
       }
       break;
     case ProtocolPhases::SENDING_CONTROL:
-      if (this->control_messages_queue_.empty()) {
+      if (this->control_queue_.empty()) {
+        bool queued = true;
         switch (this->control_method_) {
           case HonControlMethod::SET_GROUP_PARAMETERS: {
-            haier_protocol::HaierMessage control_message = this->get_control_message();
-            this->control_messages_queue_.push(control_message);
+            uint8_t control_out_buffer[MAX_CONTROL_PACKET_SIZE];
+            this->fill_control_packet_(control_out_buffer);
+            queued = this->control_queue_.push_group(control_out_buffer, this->real_control_packet_size_);
           } break;
           case HonControlMethod::SET_SINGLE_PARAMETER:
-            this->fill_control_messages_queue_();
+            queued = this->fill_control_messages_queue_();
             break;
+          case HonControlMethod::AUTO: {
+            uint8_t control_out_buffer[MAX_CONTROL_PACKET_SIZE];
+            uint8_t changed_fields[MAX_CONTROL_PACKET_SIZE];
+            this->fill_control_packet_(control_out_buffer, changed_fields);
+            bool changed = false;
+            queued = this->fill_auto_control_queue_(control_out_buffer, changed_fields, changed);
+            if (queued && !changed) {
+              ESP_LOGD(TAG, "Control packet doesn't change AC state");
+              this->reset_to_idle_();
+              return;
+            }
+          } break;
           case HonControlMethod::MONITOR_ONLY:
             ESP_LOGI(TAG, "AC control is disabled, monitor only");
             this->reset_to_idle_();
@@ -446,14 +560,32 @@ void HonClimate::process_phase(std::chrono::steady_clock::time_point now) {
             this->reset_to_idle_();
             return;
         }
+        if (!queued) {
+          ESP_LOGE(TAG, "Control commands don't fit in the queue, control is discarded");
+          this->clear_control_messages_queue_();
+          this->reset_to_idle_();
+          return;
+        }
+      } else if (this->next_hvac_settings_.valid && (this->control_method_ == HonControlMethod::SET_SINGLE_PARAMETER)) {
+        // New settings came while single parameter commands are being sent, they are merged into the queue,
+        // so unsent commands get the newest values instead of sending the old values first
+        this->current_hvac_settings_.merge(this->next_hvac_settings_);
+        this->next_hvac_settings_.reset();
+        this->last_control_timestamp_ = now;
+        if (!this->fill_control_messages_queue_()) {
+          // Settings are sent again with a new queue after the current commands
+          ESP_LOGW(TAG, "Control commands don't fit in the queue, settings are postponed");
+          this->next_hvac_settings_ = this->current_hvac_settings_;
+        }
       }
-      if (this->control_messages_queue_.empty()) {
+      if (this->control_queue_.empty()) {
         ESP_LOGW(TAG, "Control message queue is empty!");
         this->reset_to_idle_();
       } else if (this->can_send_message() && this->is_control_message_interval_exceeded_(now)) {
-        ESP_LOGI(TAG, "Sending control packet, queue size %d", this->control_messages_queue_.size());
-        this->send_message_(this->control_messages_queue_.front(), this->use_crc_, CONTROL_MESSAGE_RETRIES,
+        ESP_LOGI(TAG, "Sending control packet, queue size %zu", this->control_queue_.size());
+        this->send_message_(this->control_queue_.get_front_message(), this->use_crc_, CONTROL_MESSAGE_RETRIES,
                             CONTROL_MESSAGE_RETRIES_INTERVAL);
+        this->control_queue_.front_sent();
       }
       break;
     case ProtocolPhases::SENDING_ACTION_COMMAND:
@@ -472,12 +604,17 @@ void HonClimate::process_phase(std::chrono::steady_clock::time_point now) {
       }
       break;
     case ProtocolPhases::IDLE: {
-      if (this->forced_request_status_ || this->is_status_request_interval_exceeded_(now)) {
+      // User data, big data and alarm status requests have independent intervals,
+      // only one request is sent at a time
+      if (this->should_request_status_(now) ||
+          (this->is_big_data_request_due_(now) && this->acquire_polling_slot_(now))) {
         this->set_phase(ProtocolPhases::SENDING_STATUS_REQUEST);
         this->forced_request_status_ = false;
       } else if (std::chrono::duration_cast<std::chrono::milliseconds>(now - this->last_alarm_request_).count() >
-                 ALARM_STATUS_REQUEST_INTERVAL_MS) {
+                 this->alarm_status_interval_ms_) {
         this->set_phase(ProtocolPhases::SENDING_ALARM_STATUS_REQUEST);
+      } else if (this->device_info_check_pending_) {
+        this->set_phase(ProtocolPhases::SENDING_DEVICE_VERSION_CHECK);
       }
 #ifdef USE_WIFI
       else if (this->send_wifi_signal_ &&
@@ -523,13 +660,116 @@ void HonClimate::initialization() {
   this->current_vertical_swing_ = this->settings_.last_vertiacal_swing;
   this->current_horizontal_swing_ = this->settings_.last_horizontal_swing;
   this->quiet_mode_state_ = this->settings_.quiet_mode_state ? SwitchState::ON : SwitchState::OFF;
+#ifdef USE_SENSOR
+  if (this->is_energy_metering_enabled_()) {
+    constexpr uint32_t energy_meter_version = 0x6E3A0C55UL;
+    for (size_t i = 0; i < EnergyMeter::SAVE_SLOTS; i++)
+      this->energy_meter_.set_preference(
+          i, this->make_entity_preference<EnergyMeter::State>(energy_meter_version + i));
+    if (this->energy_meter_.restore()) {
+      this->update_sub_sensor_(SubSensorType::ENERGY, this->energy_meter_.get_total_energy_kwh());
+      this->update_sub_sensor_(SubSensorType::DAILY_ENERGY, this->energy_meter_.get_daily_energy_kwh());
+    }
+  }
+#endif  // USE_SENSOR
+#ifdef USE_TEXT_SENSOR
+  if (this->is_alarm_history_enabled_()) {
+    constexpr uint32_t alarm_history_version = 0x2B7D4E19UL;
+    this->alarm_history_.set_preference(this->make_entity_preference<AlarmHistory::State>(alarm_history_version));
+    this->alarm_history_.restore();
+    this->publish_alarm_history_();
+  }
+#endif  // USE_TEXT_SENSOR
+  if (this->fast_start_) {
+    constexpr uint32_t device_info_version = 0x3C6A91E7UL;
+    this->device_info_rtc_ = this->make_entity_preference<HonDeviceInfo>(device_info_version);
+    HonDeviceInfo stored;
+    if (this->device_info_rtc_.load(&stored) && stored.valid) {
+      if ((stored.control_packet_size ==
+           sizeof(hon_protocol::HaierPacketControl) + this->extra_control_packet_bytes_) &&
+          (stored.sensors_packet_size ==
+           sizeof(hon_protocol::HaierPacketSensors) + this->extra_sensors_packet_bytes_) &&
+          (stored.status_message_header_size == this->status_message_header_size_)) {
+        ESP_LOGD(TAG, "Restoring stored device information");
+        this->device_info_ = stored;
+        this->apply_device_info_();
+        this->device_info_check_pending_ = true;
+      } else {
+        ESP_LOGD(TAG, "Packet sizes configuration changed, stored device information is ignored");
+      }
+    }
+  }
+}
+
+void HonClimate::apply_device_info_() {
+  const HonDeviceInfo &info = this->device_info_;
+  this->hvac_hardware_info_ = HardwareInfo();
+  HardwareInfo &hw_info = this->hvac_hardware_info_.value();
+  auto copy_text = [](char *dst, const char *src) {
+    memcpy(dst, src, 8);
+    dst[8] = 0;
+  };
+  copy_text(hw_info.protocol_version_, info.protocol_version);
+  copy_text(hw_info.software_version_, info.software_version);
+  copy_text(hw_info.hardware_version_, info.hardware_version);
+  copy_text(hw_info.device_name_, info.device_name);
+#ifdef USE_TEXT_SENSOR
+  this->update_sub_text_sensor_(SubTextSensorType::APPLIANCE_NAME, hw_info.device_name_);
+  this->update_sub_text_sensor_(SubTextSensorType::PROTOCOL_VERSION, hw_info.protocol_version_);
+#endif
+  hw_info.functions_[0] = (info.functions & 0x01) != 0;  // interactive mode support
+  hw_info.functions_[1] = (info.functions & 0x02) != 0;  // controller-device mode support
+  hw_info.functions_[2] = (info.functions & 0x04) != 0;  // crc support
+  hw_info.functions_[3] = (info.functions & 0x08) != 0;  // multiple AC support
+  hw_info.functions_[4] = (info.functions & 0x20) != 0;  // roles support
+  this->use_crc_ = hw_info.functions_[2];
+  if ((info.control_packet_stored == info.control_packet_size) && (this->last_status_message_size_ == 0)) {
+    // Last known control packet, control messages can be built before the first status
+    this->real_control_packet_size_ = info.control_packet_size;
+    this->real_sensors_packet_size_ = info.sensors_packet_size;
+    memcpy(this->last_status_message_, info.control_packet, this->real_control_packet_size_);
+    this->last_status_message_size_ = this->real_control_packet_size_;
+  }
+}
+
+void HonClimate::store_control_packet_(const uint8_t *packet) {
+  if (!this->fast_start_ || !this->device_info_.valid || (this->real_control_packet_size_ > MAX_CONTROL_PACKET_SIZE))
+    return;
+  // Flash is written only when the AC state is changed
+  if ((this->device_info_.control_packet_stored == this->real_control_packet_size_) &&
+      (memcmp(this->device_info_.control_packet, packet, this->real_control_packet_size_) == 0))
+    return;
+  this->device_info_.control_packet_stored = this->real_control_packet_size_;
+  memcpy(this->device_info_.control_packet, packet, this->real_control_packet_size_);
+  this->device_info_rtc_.save(&this->device_info_);
+}
+
+void HonClimate::invalidate_device_info_() {
+  ESP_LOGW(TAG, "Stored device information doesn't match AC, it is invalidated");
+  this->device_info_ = HonDeviceInfo{};
+  this->device_info_rtc_.save(&this->device_info_);
+  this->hvac_hardware_info_.reset();
 }
 
 haier_protocol::HaierMessage HonClimate::get_control_message() {
-  uint8_t control_out_buffer[haier_protocol::MAX_FRAME_SIZE];
-  memcpy(control_out_buffer, this->last_status_message_.get(), this->real_control_packet_size_);
-  hon_protocol::HaierPacketControl *out_data = (hon_protocol::HaierPacketControl *) control_out_buffer;
+  uint8_t control_out_buffer[MAX_CONTROL_PACKET_SIZE];
+  this->fill_control_packet_(control_out_buffer);
+  return haier_protocol::HaierMessage(haier_protocol::FrameType::CONTROL,
+                                      (uint16_t) hon_protocol::SubcommandsControl::SET_GROUP_PARAMETERS,
+                                      control_out_buffer, this->real_control_packet_size_);
+}
+
+void HonClimate::fill_control_packet_(uint8_t *control_out_buffer, uint8_t *changed_fields) {
+  namespace fields = hon_protocol::control_fields;
+  memcpy(control_out_buffer, this->last_status_message_, this->real_control_packet_size_);
   control_out_buffer[4] = 0;  // This byte should be cleared before setting values
+  if (changed_fields != nullptr)
+    memset(changed_fields, 0, this->real_control_packet_size_);
+  auto set_field = [control_out_buffer, changed_fields](const PacketField &field, uint8_t value) {
+    field.set(control_out_buffer, value);
+    if (changed_fields != nullptr)
+      changed_fields[field.offset] |= field.mask();
+  };
   bool has_hvac_settings = false;
   if (this->current_hvac_settings_.valid) {
     has_hvac_settings = true;
@@ -537,34 +777,35 @@ haier_protocol::HaierMessage HonClimate::get_control_message() {
     if (climate_control.mode.has_value()) {
       switch (climate_control.mode.value()) {
         case CLIMATE_MODE_OFF:
-          out_data->ac_power = 0;
+          set_field(fields::AC_POWER, 0);
           break;
         case CLIMATE_MODE_HEAT_COOL:
-          out_data->ac_power = 1;
-          out_data->ac_mode = (uint8_t) hon_protocol::ConditioningMode::AUTO;
-          out_data->fan_mode = this->other_modes_fan_speed_;
+          set_field(fields::AC_POWER, 1);
+          set_field(fields::AC_MODE, (uint8_t) hon_protocol::ConditioningMode::AUTO);
+          set_field(fields::FAN_MODE, this->other_modes_fan_speed_);
           break;
         case CLIMATE_MODE_HEAT:
-          out_data->ac_power = 1;
-          out_data->ac_mode = (uint8_t) hon_protocol::ConditioningMode::HEAT;
-          out_data->fan_mode = this->other_modes_fan_speed_;
+          set_field(fields::AC_POWER, 1);
+          set_field(fields::AC_MODE, (uint8_t) hon_protocol::ConditioningMode::HEAT);
+          set_field(fields::FAN_MODE, this->other_modes_fan_speed_);
           break;
         case CLIMATE_MODE_DRY:
-          out_data->ac_power = 1;
-          out_data->ac_mode = (uint8_t) hon_protocol::ConditioningMode::DRY;
-          out_data->fan_mode = this->other_modes_fan_speed_;
+          set_field(fields::AC_POWER, 1);
+          set_field(fields::AC_MODE, (uint8_t) hon_protocol::ConditioningMode::DRY);
+          set_field(fields::FAN_MODE, this->other_modes_fan_speed_);
           break;
         case CLIMATE_MODE_FAN_ONLY:
-          out_data->ac_power = 1;
-          out_data->ac_mode = (uint8_t) hon_protocol::ConditioningMode::FAN;
-          out_data->fan_mode = this->fan_mode_speed_;  // Auto doesn't work in fan only mode
+          set_field(fields::AC_POWER, 1);
+          set_field(fields::AC_MODE, (uint8_t) hon_protocol::ConditioningMode::FAN);
+          // Auto doesn't work in fan only mode
+          set_field(fields::FAN_MODE, this->fan_mode_speed_);
           // Disabling boost for Fan only
-          out_data->fast_mode = 0;
+          set_field(fields::FAST_MODE, 0);
           break;
         case CLIMATE_MODE_COOL:
-          out_data->ac_power = 1;
-          out_data->ac_mode = (uint8_t) hon_protocol::ConditioningMode::COOL;
-          out_data->fan_mode = this->other_modes_fan_speed_;
+          set_field(fields::AC_POWER, 1);
+          set_field(fields::AC_MODE, (uint8_t) hon_protocol::ConditioningMode::COOL);
+          set_field(fields::FAN_MODE, this->other_modes_fan_speed_);
           break;
         default:
           ESP_LOGE("Control", "Unsupported climate mode");
@@ -575,17 +816,17 @@ haier_protocol::HaierMessage HonClimate::get_control_message() {
     if (climate_control.fan_mode.has_value()) {
       switch (climate_control.fan_mode.value()) {
         case CLIMATE_FAN_LOW:
-          out_data->fan_mode = (uint8_t) hon_protocol::FanMode::FAN_LOW;
+          set_field(fields::FAN_MODE, (uint8_t) hon_protocol::FanMode::FAN_LOW);
           break;
         case CLIMATE_FAN_MEDIUM:
-          out_data->fan_mode = (uint8_t) hon_protocol::FanMode::FAN_MID;
+          set_field(fields::FAN_MODE, (uint8_t) hon_protocol::FanMode::FAN_MID);
           break;
         case CLIMATE_FAN_HIGH:
-          out_data->fan_mode = (uint8_t) hon_protocol::FanMode::FAN_HIGH;
+          set_field(fields::FAN_MODE, (uint8_t) hon_protocol::FanMode::FAN_HIGH);
           break;
         case CLIMATE_FAN_AUTO:
           if (mode != CLIMATE_MODE_FAN_ONLY)  // if we are not in fan only mode
-            out_data->fan_mode = (uint8_t) hon_protocol::FanMode::FAN_AUTO;
+            set_field(fields::FAN_MODE, (uint8_t) hon_protocol::FanMode::FAN_AUTO);
           break;
         default:
           ESP_LOGE("Control", "Unsupported fan mode");
@@ -596,139 +837,140 @@ haier_protocol::HaierMessage HonClimate::get_control_message() {
     if (climate_control.swing_mode.has_value()) {
       switch (climate_control.swing_mode.value()) {
         case CLIMATE_SWING_OFF:
-          out_data->horizontal_swing_mode = (uint8_t) this->settings_.last_horizontal_swing;
-          out_data->vertical_swing_mode = (uint8_t) this->settings_.last_vertiacal_swing;
+          set_field(fields::HORIZONTAL_SWING_MODE, (uint8_t) this->settings_.last_horizontal_swing);
+          set_field(fields::VERTICAL_SWING_MODE, (uint8_t) this->settings_.last_vertiacal_swing);
           break;
         case CLIMATE_SWING_VERTICAL:
-          out_data->horizontal_swing_mode = (uint8_t) this->settings_.last_horizontal_swing;
-          out_data->vertical_swing_mode = (uint8_t) hon_protocol::VerticalSwingMode::AUTO;
+          set_field(fields::HORIZONTAL_SWING_MODE, (uint8_t) this->settings_.last_horizontal_swing);
+          set_field(fields::VERTICAL_SWING_MODE, (uint8_t) hon_protocol::VerticalSwingMode::AUTO);
           break;
         case CLIMATE_SWING_HORIZONTAL:
-          out_data->horizontal_swing_mode = (uint8_t) hon_protocol::HorizontalSwingMode::AUTO;
-          out_data->vertical_swing_mode = (uint8_t) this->settings_.last_vertiacal_swing;
+          set_field(fields::HORIZONTAL_SWING_MODE, (uint8_t) hon_protocol::HorizontalSwingMode::AUTO);
+          set_field(fields::VERTICAL_SWING_MODE, (uint8_t) this->settings_.last_vertiacal_swing);
           break;
         case CLIMATE_SWING_BOTH:
-          out_data->horizontal_swing_mode = (uint8_t) hon_protocol::HorizontalSwingMode::AUTO;
-          out_data->vertical_swing_mode = (uint8_t) hon_protocol::VerticalSwingMode::AUTO;
+          set_field(fields::HORIZONTAL_SWING_MODE, (uint8_t) hon_protocol::HorizontalSwingMode::AUTO);
+          set_field(fields::VERTICAL_SWING_MODE, (uint8_t) hon_protocol::VerticalSwingMode::AUTO);
           break;
       }
     }
     if (climate_control.target_temperature.has_value()) {
       float target_temp = climate_control.target_temperature.value();
-      out_data->set_point = ((int) target_temp) - 16;  // set the temperature with offset 16
-      out_data->half_degree = (target_temp - ((int) target_temp) >= 0.49) ? 1 : 0;
+      // set the temperature with offset 16
+      set_field(fields::SET_POINT, ((int) target_temp) - 16);
+      set_field(fields::HALF_DEGREE, (target_temp - ((int) target_temp) >= 0.49) ? 1 : 0);
     }
-    if (out_data->ac_power == 0) {
+    if (fields::AC_POWER.get(control_out_buffer) == 0) {
       // If AC is off - no presets allowed
-      out_data->fast_mode = 0;
-      out_data->sleep_mode = 0;
+      set_field(fields::FAST_MODE, 0);
+      set_field(fields::SLEEP_MODE, 0);
     } else if (climate_control.preset.has_value()) {
       switch (climate_control.preset.value()) {
         case CLIMATE_PRESET_NONE:
-          out_data->fast_mode = 0;
-          out_data->sleep_mode = 0;
-          out_data->ten_degree = 0;
+          set_field(fields::FAST_MODE, 0);
+          set_field(fields::SLEEP_MODE, 0);
+          set_field(fields::TEN_DEGREE, 0);
           break;
         case CLIMATE_PRESET_BOOST:
           // Boost is not supported in Fan only mode
-          out_data->fast_mode = (this->mode != CLIMATE_MODE_FAN_ONLY) ? 1 : 0;
-          out_data->sleep_mode = 0;
-          out_data->ten_degree = 0;
+          set_field(fields::FAST_MODE, (this->mode != CLIMATE_MODE_FAN_ONLY) ? 1 : 0);
+          set_field(fields::SLEEP_MODE, 0);
+          set_field(fields::TEN_DEGREE, 0);
           break;
         case CLIMATE_PRESET_AWAY:
-          out_data->fast_mode = 0;
-          out_data->sleep_mode = 0;
+          set_field(fields::FAST_MODE, 0);
+          set_field(fields::SLEEP_MODE, 0);
           // 10 degrees allowed only in heat mode
-          out_data->ten_degree = (this->mode == CLIMATE_MODE_HEAT) ? 1 : 0;
+          set_field(fields::TEN_DEGREE, (this->mode == CLIMATE_MODE_HEAT) ? 1 : 0);
           break;
         case CLIMATE_PRESET_SLEEP:
-          out_data->fast_mode = 0;
-          out_data->sleep_mode = 1;
-          out_data->ten_degree = 0;
+          set_field(fields::FAST_MODE, 0);
+          set_field(fields::SLEEP_MODE, 1);
+          set_field(fields::TEN_DEGREE, 0);
           break;
         default:
           ESP_LOGE("Control", "Unsupported preset");
-          out_data->fast_mode = 0;
-          out_data->sleep_mode = 0;
-          out_data->ten_degree = 0;
+          set_field(fields::FAST_MODE, 0);
+          set_field(fields::SLEEP_MODE, 0);
+          set_field(fields::TEN_DEGREE, 0);
           break;
       }
     }
   }
   if (this->pending_vertical_direction_.has_value()) {
-    out_data->vertical_swing_mode = (uint8_t) this->pending_vertical_direction_.value();
+    set_field(fields::VERTICAL_SWING_MODE, (uint8_t) this->pending_vertical_direction_.value());
     this->pending_vertical_direction_.reset();
   }
   if (this->pending_horizontal_direction_.has_value()) {
-    out_data->horizontal_swing_mode = (uint8_t) this->pending_horizontal_direction_.value();
+    set_field(fields::HORIZONTAL_SWING_MODE, (uint8_t) this->pending_horizontal_direction_.value());
     this->pending_horizontal_direction_.reset();
   }
   {
     // Quiet mode
-    if ((out_data->ac_power == 0) || (out_data->ac_mode == (uint8_t) hon_protocol::ConditioningMode::FAN)) {
+    if ((fields::AC_POWER.get(control_out_buffer) == 0) ||
+        (fields::AC_MODE.get(control_out_buffer) == (uint8_t) hon_protocol::ConditioningMode::FAN)) {
       // If AC is off or in fan only mode - no quiet mode allowed
-      out_data->quiet_mode = 0;
+      set_field(fields::QUIET_MODE, 0);
     } else {
-      out_data->quiet_mode = this->get_quiet_mode_state() ? 1 : 0;
+      set_field(fields::QUIET_MODE, this->get_quiet_mode_state() ? 1 : 0);
     }
     // Clean quiet mode state pending flag
     this->quiet_mode_state_ = (SwitchState) ((uint8_t) this->quiet_mode_state_ & 0b01);
   }
-  out_data->beeper_status = ((!this->get_beeper_state()) || (!has_hvac_settings)) ? 1 : 0;
-  out_data->display_status = this->get_display_state() ? 1 : 0;
+  // Beeper bit is a flag of the command, not a state change
+  fields::BEEPER_STATUS.set(control_out_buffer, ((!this->get_beeper_state()) || (!has_hvac_settings)) ? 1 : 0);
+  set_field(fields::DISPLAY_STATUS, this->get_display_state() ? 1 : 0);
   this->display_status_ = (SwitchState) ((uint8_t) this->display_status_ & 0b01);
-  out_data->health_mode = this->get_health_mode() ? 1 : 0;
+  set_field(fields::HEALTH_MODE, this->get_health_mode() ? 1 : 0);
   this->health_mode_ = (SwitchState) ((uint8_t) this->health_mode_ & 0b01);
-  return haier_protocol::HaierMessage(haier_protocol::FrameType::CONTROL,
-                                      (uint16_t) hon_protocol::SubcommandsControl::SET_GROUP_PARAMETERS,
-                                      control_out_buffer, this->real_control_packet_size_);
 }
 
 void HonClimate::process_alarm_message_(const uint8_t *packet, uint8_t size, bool check_new) {
   constexpr size_t active_alarms_size = sizeof(this->active_alarms_);
   if (size >= active_alarms_size + 2) {
+    // Alarm bitmap is processed as one big endian word, so bit number is the alarm code
+    uint64_t new_alarms = 0;
+    uint64_t old_alarms = 0;
+    for (size_t i = 0; i < active_alarms_size; i++) {
+      new_alarms = (new_alarms << 8) | packet[2 + i];
+      old_alarms = (old_alarms << 8) | this->active_alarms_[i];
+    }
     if (check_new) {
-      size_t alarm_code = 0;
-      for (int i = active_alarms_size - 1; i >= 0; i--) {
-        if (packet[2 + i] != active_alarms_[i]) {
-          uint8_t alarm_bit = 1;
-          for (int b = 0; b < 8; b++) {
-            if ((packet[2 + i] & alarm_bit) != (this->active_alarms_[i] & alarm_bit)) {
-              bool alarm_status = (packet[2 + i] & alarm_bit) != 0;
-              int log_level = alarm_status ? ESPHOME_LOG_LEVEL_WARN : ESPHOME_LOG_LEVEL_INFO;
-              const char *alarm_message = alarm_code < esphome::haier::hon_protocol::HON_ALARM_COUNT
-                                              ? esphome::haier::hon_protocol::HON_ALARM_MESSAGES[alarm_code].c_str()
-                                              : "Unknown";
-              esp_log_printf_(log_level, TAG, __LINE__, "Alarm %s (%d): %s", alarm_status ? "activated" : "deactivated",
-                              alarm_code, alarm_message);
-              if (alarm_status) {
-                this->alarm_start_callback_.call(alarm_code, alarm_message);
-                this->active_alarm_count_ += 1.0f;
-              } else {
-                this->alarm_end_callback_.call(alarm_code, alarm_message);
-                this->active_alarm_count_ -= 1.0f;
-              }
-            }
-            alarm_bit <<= 1;
-            alarm_code++;
-          }
-          active_alarms_[i] = packet[2 + i];
+      char alarm_message_buffer[hon_protocol::HON_ALARM_MESSAGE_SIZE];
+      uint64_t changed_alarms = new_alarms ^ old_alarms;
+      while (changed_alarms != 0) {
+        uint8_t alarm_code = __builtin_ctzll(changed_alarms);
+        changed_alarms &= changed_alarms - 1;
+        const char *alarm_message = hon_protocol::get_alarm_message(alarm_code, alarm_message_buffer);
+        if ((new_alarms >> alarm_code) & 1) {
+          ESP_LOGW(TAG, "Alarm activated (%u): %s", alarm_code, alarm_message);
+          this->alarm_start_callback_.call(alarm_code, alarm_message);
         } else {
-          alarm_code += 8;
+          ESP_LOGI(TAG, "Alarm deactivated (%u): %s", alarm_code, alarm_message);
+          this->alarm_end_callback_.call(alarm_code, alarm_message);
         }
       }
-    } else {
-      float alarm_count = 0.0f;
-      static uint8_t nibble_bits_count[] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
-      for (size_t i = 0; i < sizeof(this->active_alarms_); i++) {
-        alarm_count += (float) (nibble_bits_count[packet[2 + i] & 0x0F] + nibble_bits_count[packet[2 + i] >> 4]);
-      }
-      this->active_alarm_count_ = alarm_count;
-      memcpy(this->active_alarms_, packet + 2, sizeof(this->active_alarms_));
     }
+#ifdef USE_TEXT_SENSOR
+    if (this->is_alarm_history_enabled_())
+      this->update_alarm_history_(old_alarms, new_alarms, check_new);
+#endif
+    this->active_alarm_count_ = (float) __builtin_popcountll(new_alarms);
+    memcpy(this->active_alarms_, packet + 2, active_alarms_size);
   }
 }
 
+void HonClimate::on_shutdown() {
+#ifdef USE_SENSOR
+  if (this->is_energy_metering_enabled_())
+    this->energy_meter_.save(std::chrono::steady_clock::now(), true);
+#endif
+#ifdef USE_TEXT_SENSOR
+  if (this->is_alarm_history_enabled_())
+    this->alarm_history_.save(std::chrono::steady_clock::now(), true);
+#endif
+}
+
 #ifdef USE_SENSOR
 void HonClimate::set_sub_sensor(SubSensorType type, sensor::Sensor *sens) {
   if (type < SubSensorType::SUB_SENSOR_TYPE_COUNT) {
@@ -743,12 +985,42 @@ void HonClimate::set_sub_sensor(SubSensorType type, sensor::Sensor *sens) {
   }
 }
 
+void HonClimate::set_sub_sensor_publish_filter(SubSensorType type, float deadband, uint32_t min_interval_ms,
+                                               uint32_t heartbeat_ms) {
+  if (type < SubSensorType::SUB_SENSOR_TYPE_COUNT)
+    this->sub_sensor_filters_[(size_t) type].set_parameters(deadband, min_interval_ms, heartbeat_ms);
+}
+
+bool HonClimate::is_energy_metering_enabled_() const {
+  return (this->sub_sensors_[(size_t) SubSensorType::ENERGY] != nullptr) ||
+         (this->sub_sensors_[(size_t) SubSensorType::DAILY_ENERGY] != nullptr);
+}
+
+void HonClimate::update_energy_meter_(float power_w) {
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+#ifdef USE_TIME
+  if (this->energy_time_ != nullptr) {
+    ESPTime time = this->energy_time_->now();
+    if (time.is_valid())
+      this->energy_meter_.set_day(time.year * 1000 + time.day_of_year);
+  }
+#endif
+  this->energy_meter_.add_sample(power_w, now);
+  this->energy_meter_.save(now);
+  this->update_sub_sensor_(SubSensorType::ENERGY, this->energy_meter_.get_total_energy_kwh());
+  this->update_sub_sensor_(SubSensorType::DAILY_ENERGY, this->energy_meter_.get_daily_energy_kwh());
+}
+
 void HonClimate::update_sub_sensor_(SubSensorType type, float value) {
   if (type < SubSensorType::SUB_SENSOR_TYPE_COUNT) {
     size_t index = (size_t) type;
-    if ((this->sub_sensors_[index] != nullptr) &&
-        ((!this->sub_sensors_[index]->has_state()) || (this->sub_sensors_[index]->get_raw_state() != value)))
+    if (this->sub_sensors_[index] == nullptr)
+      return;
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (this->sub_sensor_filters_[index].should_publish(value, now)) {
       this->sub_sensors_[index]->publish_state(value);
+      this->sub_sensor_filters_[index].published(value, now);
+    }
   }
 }
 #endif  // USE_SENSOR
@@ -796,11 +1068,61 @@ void HonClimate::set_sub_text_sensor(SubTextSensorType type, text_sensor::TextSe
   }
 }
 
-void HonClimate::update_sub_text_sensor_(SubTextSensorType type, const std::string &value) {
+void HonClimate::update_sub_text_sensor_(SubTextSensorType type, const char *value) {
   size_t index = (size_t) type;
   if (this->sub_text_sensors_[index] != nullptr)
     this->sub_text_sensors_[index]->publish_state(value);
 }
+
+bool HonClimate::is_alarm_history_enabled_() const {
+  return this->sub_text_sensors_[(size_t) SubTextSensorType::ALARM_HISTORY] != nullptr;
+}
+
+void HonClimate::update_alarm_history_(uint64_t old_alarms, uint64_t new_alarms, bool check_new) {
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  this->alarm_history_.update_active_time(old_alarms, now);
+  if (check_new && (old_alarms != new_alarms)) {
+    uint32_t timestamp = 0;
+#ifdef USE_TIME
+    if ((this->alarm_history_time_ != nullptr) && this->alarm_history_time_->now().is_valid())
+      timestamp = this->alarm_history_time_->timestamp_now();
+#endif
+    for (uint64_t changed_alarms = old_alarms ^ new_alarms; changed_alarms != 0; changed_alarms &= changed_alarms - 1) {
+      uint8_t alarm_code = __builtin_ctzll(changed_alarms);
+      this->alarm_history_.add_event(alarm_code, (new_alarms >> alarm_code) & 1, timestamp, now);
+    }
+    this->publish_alarm_history_();
+  }
+  this->alarm_history_.save(now);
+}
+
+void HonClimate::publish_alarm_history_() {
+  // Newest events first, as many as fit into the text sensor state
+  constexpr size_t max_state_size = 255;
+  char state[max_state_size + 1];
+  size_t state_size = 0;
+  state[0] = 0;
+  for (size_t i = 0; i < this->alarm_history_.size(); i++) {
+    const AlarmHistory::Event &event = this->alarm_history_.get_event(i);
+    char time_text[24];
+#ifdef USE_TIME
+    if (event.timestamp != 0) {
+      ESPTime::from_epoch_local(event.timestamp).strftime(time_text, sizeof(time_text), "%Y-%m-%d %H:%M");
+    } else
+#endif
+    {
+      snprintf(time_text, sizeof(time_text), "boot %u +%" PRIu32 "s", event.boot, event.uptime_s);
+    }
+    char event_text[48];
+    int event_size = snprintf(event_text, sizeof(event_text), "%s%u %s %s", (i == 0) ? "" : "; ", event.code,
+                              event.active ? "on" : "off", time_text);
+    if ((event_size < 0) || (state_size + event_size > max_state_size))
+      break;
+    memcpy(state + state_size, event_text, event_size + 1);
+    state_size += event_size;
+  }
+  this->update_sub_text_sensor_(SubTextSensorType::ALARM_HISTORY, state);
+}
 #endif  // USE_TEXT_SENSOR
 
 #ifdef USE_SWITCH
@@ -826,66 +1148,67 @@ haier_protocol::HandlerError HonClimate::process_status_message_(const uint8_t *
     ESP_LOGW(TAG, "Unexpected message size %u (expexted >= %zu)", size, expected_size);
     return haier_protocol::HandlerError::WRONG_MESSAGE_STRUCTURE;
   }
-  uint16_t subtype = (((uint16_t) packet_buffer[0]) << 8) + packet_buffer[1];
-  if ((subtype == 0x7D01) && (size >= expected_size + sizeof(hon_protocol::HaierPacketBigData))) {
+  PacketView status(packet_buffer, size);
+  uint16_t subtype = status.get_uint16(0);
+  if ((subtype == 0x7D01) && status.contains(expected_size, sizeof(hon_protocol::HaierPacketBigData))) {
     // Got BigData packet
-    const hon_protocol::HaierPacketBigData *bd_packet =
-        (const hon_protocol::HaierPacketBigData *) (&packet_buffer[expected_size]);
+    hon_protocol::HaierPacketBigDataView bd_packet(
+        status.sub_view(expected_size, sizeof(hon_protocol::HaierPacketBigData)));
+    // Compressor frequency is changing, AC state is not settled yet
+    this->compressor_ramping_ = bd_packet.compressor_frequency() != this->last_compressor_frequency_;
+    this->last_compressor_frequency_ = bd_packet.compressor_frequency();
 #ifdef USE_SENSOR
-    this->update_sub_sensor_(SubSensorType::INDOOR_COIL_TEMPERATURE, bd_packet->indoor_coil_temperature / 2.0 - 20);
-    this->update_sub_sensor_(SubSensorType::OUTDOOR_COIL_TEMPERATURE, bd_packet->outdoor_coil_temperature - 64);
-    this->update_sub_sensor_(SubSensorType::OUTDOOR_DEFROST_TEMPERATURE, bd_packet->outdoor_coil_temperature - 64);
-    this->update_sub_sensor_(SubSensorType::OUTDOOR_IN_AIR_TEMPERATURE, bd_packet->outdoor_in_air_temperature - 64);
-    this->update_sub_sensor_(SubSensorType::OUTDOOR_OUT_AIR_TEMPERATURE, bd_packet->outdoor_out_air_temperature - 64);
-    this->update_sub_sensor_(SubSensorType::POWER, encode_uint16(bd_packet->power[0], bd_packet->power[1]));
-    this->update_sub_sensor_(SubSensorType::COMPRESSOR_FREQUENCY, bd_packet->compressor_frequency);
-    this->update_sub_sensor_(SubSensorType::COMPRESSOR_CURRENT,
-                             encode_uint16(bd_packet->compressor_current[0], bd_packet->compressor_current[1]) / 10.0);
-    this->update_sub_sensor_(
-        SubSensorType::EXPANSION_VALVE_OPEN_DEGREE,
-        encode_uint16(bd_packet->expansion_valve_open_degree[0], bd_packet->expansion_valve_open_degree[1]) / 4095.0);
+    this->update_sub_sensor_(SubSensorType::INDOOR_COIL_TEMPERATURE, bd_packet.indoor_coil_temperature() / 2.0 - 20);
+    this->update_sub_sensor_(SubSensorType::OUTDOOR_COIL_TEMPERATURE, bd_packet.outdoor_coil_temperature() - 64);
+    this->update_sub_sensor_(SubSensorType::OUTDOOR_DEFROST_TEMPERATURE, bd_packet.outdoor_coil_temperature() - 64);
+    this->update_sub_sensor_(SubSensorType::OUTDOOR_IN_AIR_TEMPERATURE, bd_packet.outdoor_in_air_temperature() - 64);
+    this->update_sub_sensor_(SubSensorType::OUTDOOR_OUT_AIR_TEMPERATURE, bd_packet.outdoor_out_air_temperature() - 64);
+    this->update_sub_sensor_(SubSensorType::POWER, bd_packet.power());
+    if (this->is_energy_metering_enabled_())
+      this->update_energy_meter_(bd_packet.power());
+    this->update_sub_sensor_(SubSensorType::COMPRESSOR_FREQUENCY, bd_packet.compressor_frequency());
+    this->update_sub_sensor_(SubSensorType::COMPRESSOR_CURRENT, bd_packet.compressor_current() / 10.0);
+    this->update_sub_sensor_(SubSensorType::EXPANSION_VALVE_OPEN_DEGREE,
+                             bd_packet.expansion_valve_open_degree() / 4095.0);
 #endif  // USE_SENSOR
 #ifdef USE_BINARY_SENSOR
-    this->update_sub_binary_sensor_(SubBinarySensorType::OUTDOOR_FAN_STATUS, bd_packet->outdoor_fan_status);
-    this->update_sub_binary_sensor_(SubBinarySensorType::DEFROST_STATUS, bd_packet->defrost_status);
-    this->update_sub_binary_sensor_(SubBinarySensorType::COMPRESSOR_STATUS, bd_packet->compressor_status);
-    this->update_sub_binary_sensor_(SubBinarySensorType::INDOOR_FAN_STATUS, bd_packet->indoor_fan_status);
-    this->update_sub_binary_sensor_(SubBinarySensorType::FOUR_WAY_VALVE_STATUS, bd_packet->four_way_valve_status);
+    this->update_sub_binary_sensor_(SubBinarySensorType::OUTDOOR_FAN_STATUS, bd_packet.outdoor_fan_status());
+    this->update_sub_binary_sensor_(SubBinarySensorType::DEFROST_STATUS, bd_packet.defrost_status());
+    this->update_sub_binary_sensor_(SubBinarySensorType::COMPRESSOR_STATUS, bd_packet.compressor_status());
+    this->update_sub_binary_sensor_(SubBinarySensorType::INDOOR_FAN_STATUS, bd_packet.indoor_fan_status());
+    this->update_sub_binary_sensor_(SubBinarySensorType::FOUR_WAY_VALVE_STATUS, bd_packet.four_way_valve_status());
     this->update_sub_binary_sensor_(SubBinarySensorType::INDOOR_ELECTRIC_HEATING_STATUS,
-                                    bd_packet->indoor_electric_heating_status);
+                                    bd_packet.indoor_electric_heating_status());
 #endif  // USE_BINARY_SENSOR
   }
-  struct {
-    hon_protocol::HaierPacketControl control;
-    hon_protocol::HaierPacketSensors sensors;
-  } packet;
-  memcpy(&packet.control, packet_buffer + 2 + this->status_message_header_size_,
-         sizeof(hon_protocol::HaierPacketControl));
-  memcpy(&packet.sensors, packet_buffer + 2 + this->status_message_header_size_ + this->real_control_packet_size_,
-         sizeof(hon_protocol::HaierPacketSensors));
-  if (packet.sensors.error_status != 0) {
-    ESP_LOGW(TAG, "HVAC error, code=0x%02X", packet.sensors.error_status);
+  hon_protocol::HaierPacketControlView control(
+      status.sub_view(2 + this->status_message_header_size_, sizeof(hon_protocol::HaierPacketControl)));
+  hon_protocol::HaierPacketSensorsView sensors(
+      status.sub_view(2 + this->status_message_header_size_ + this->real_control_packet_size_,
+                      sizeof(hon_protocol::HaierPacketSensors)));
+  if (sensors.error_status() != 0) {
+    ESP_LOGW(TAG, "HVAC error, code=0x%02X", sensors.error_status());
   }
 #ifdef USE_SENSOR
   if ((this->sub_sensors_[(size_t) SubSensorType::OUTDOOR_TEMPERATURE] != nullptr) &&
-      (this->got_valid_outdoor_temp_ || (packet.sensors.outdoor_temperature > 0))) {
+      (this->got_valid_outdoor_temp_ || (sensors.outdoor_temperature() > 0))) {
     this->got_valid_outdoor_temp_ = true;
     this->update_sub_sensor_(SubSensorType::OUTDOOR_TEMPERATURE,
-                             (float) (packet.sensors.outdoor_temperature + PROTOCOL_OUTDOOR_TEMPERATURE_OFFSET));
+                             (float) (sensors.outdoor_temperature() + PROTOCOL_OUTDOOR_TEMPERATURE_OFFSET));
   }
-  if ((this->sub_sensors_[(size_t) SubSensorType::HUMIDITY] != nullptr) && (packet.sensors.room_humidity <= 100)) {
-    this->update_sub_sensor_(SubSensorType::HUMIDITY, (float) packet.sensors.room_humidity);
+  if ((this->sub_sensors_[(size_t) SubSensorType::HUMIDITY] != nullptr) && (sensors.room_humidity() <= 100)) {
+    this->update_sub_sensor_(SubSensorType::HUMIDITY, (float) sensors.room_humidity());
   }
 #endif  // USE_SENSOR
   bool should_publish = false;
   {
     // Extra modes/presets
     optional<ClimatePreset> old_preset = this->preset;
-    if (packet.control.fast_mode != 0) {
+    if (control.fast_mode()) {
       this->preset = CLIMATE_PRESET_BOOST;
-    } else if (packet.control.sleep_mode != 0) {
+    } else if (control.sleep_mode()) {
       this->preset = CLIMATE_PRESET_SLEEP;
-    } else if (packet.control.ten_degree != 0) {
+    } else if (control.ten_degree()) {
       this->preset = CLIMATE_PRESET_AWAY;
     } else {
       this->preset = CLIMATE_PRESET_NONE;
@@ -896,28 +1219,28 @@ haier_protocol::HandlerError HonClimate::process_status_message_(const uint8_t *
   {
     // Target temperature
     float old_target_temperature = this->target_temperature;
-    this->target_temperature = packet.control.set_point + 16.0f + ((packet.control.half_degree == 1) ? 0.5f : 0.0f);
+    this->target_temperature = control.set_point() + 16.0f + (control.half_degree() ? 0.5f : 0.0f);
     should_publish = should_publish || (old_target_temperature != this->target_temperature);
   }
   {
     // Current temperature
-    float old_current_temperature = this->current_temperature;
-    this->current_temperature = packet.sensors.room_temperature / 2.0f;
-    should_publish = should_publish || (old_current_temperature != this->current_temperature);
+    this->current_temperature = sensors.room_temperature() / 2.0f;
+    should_publish = should_publish || this->current_temperature_filter_.should_publish(
+                                           this->current_temperature, std::chrono::steady_clock::now());
   }
   {
     // Fan mode
     optional<ClimateFanMode> old_fan_mode = this->fan_mode;
     // remember the fan speed we last had for climate vs fan
-    if (packet.control.ac_mode == (uint8_t) hon_protocol::ConditioningMode::FAN) {
-      if (packet.control.fan_mode != (uint8_t) hon_protocol::FanMode::FAN_AUTO)
-        this->fan_mode_speed_ = packet.control.fan_mode;
+    if (control.ac_mode() == (uint8_t) hon_protocol::ConditioningMode::FAN) {
+      if (control.fan_mode() != (uint8_t) hon_protocol::FanMode::FAN_AUTO)
+        this->fan_mode_speed_ = control.fan_mode();
     } else {
-      this->other_modes_fan_speed_ = packet.control.fan_mode;
+      this->other_modes_fan_speed_ = control.fan_mode();
     }
-    switch (packet.control.fan_mode) {
+    switch (control.fan_mode()) {
       case (uint8_t) hon_protocol::FanMode::FAN_AUTO:
-        if (packet.control.ac_mode != (uint8_t) hon_protocol::ConditioningMode::FAN) {
+        if (control.ac_mode() != (uint8_t) hon_protocol::ConditioningMode::FAN) {
           this->fan_mode = CLIMATE_FAN_AUTO;
         } else {
           // Shouldn't accept fan speed auto in fan-only mode even if AC reports it
@@ -939,9 +1262,9 @@ haier_protocol::HandlerError HonClimate::process_status_message_(const uint8_t *
   }
   // Display status
   // should be before "Climate mode" because it is changing this->mode
-  if (packet.control.ac_power != 0) {
+  if (control.ac_power()) {
     // if AC is off display status always ON so process it only when AC is on
-    bool disp_status = packet.control.display_status != 0;
+    bool disp_status = control.display_status();
     if (disp_status != this->get_display_state()) {
       // Do something only if display status changed
       if (this->mode == CLIMATE_MODE_OFF) {
@@ -955,15 +1278,15 @@ haier_protocol::HandlerError HonClimate::process_status_message_(const uint8_t *
   // Health mode
   if ((((uint8_t) this->health_mode_) & 0b10) == 0) {
     bool old_health_mode = this->get_health_mode();
-    this->health_mode_ = packet.control.health_mode == 1 ? SwitchState::ON : SwitchState::OFF;
+    this->health_mode_ = control.health_mode() ? SwitchState::ON : SwitchState::OFF;
     should_publish = should_publish || (old_health_mode != this->get_health_mode());
   }
   {
     CleaningState new_cleaning;
-    if (packet.control.steri_clean == 1) {
+    if (control.steri_clean()) {
       // Steri-cleaning
       new_cleaning = CleaningState::STERI_CLEAN;
-    } else if (packet.control.self_cleaning_status == 1) {
+    } else if (control.self_cleaning_status()) {
       // Self-cleaning
       new_cleaning = CleaningState::SELF_CLEAN;
     } else {
@@ -986,11 +1309,11 @@ haier_protocol::HandlerError HonClimate::process_status_message_(const uint8_t *
   {
     // Climate mode
     ClimateMode old_mode = this->mode;
-    if (packet.control.ac_power == 0) {
+    if (!control.ac_power()) {
       this->mode = CLIMATE_MODE_OFF;
     } else {
       // Check current hvac mode
-      switch (packet.control.ac_mode) {
+      switch (control.ac_mode()) {
         case (uint8_t) hon_protocol::ConditioningMode::COOL:
           this->mode = CLIMATE_MODE_COOL;
           break;
@@ -1015,7 +1338,7 @@ haier_protocol::HandlerError HonClimate::process_status_message_(const uint8_t *
     if ((this->mode != CLIMATE_MODE_FAN_ONLY) && (this->mode != CLIMATE_MODE_OFF) &&
         ((((uint8_t) this->quiet_mode_state_) & 0b10) == 0)) {
       // In proper mode and not in pending state
-      bool new_quiet_mode = packet.control.quiet_mode != 0;
+      bool new_quiet_mode = control.quiet_mode();
       if (new_quiet_mode != this->get_quiet_mode_state()) {
         this->quiet_mode_state_ = new_quiet_mode ? SwitchState::ON : SwitchState::OFF;
         this->settings_.quiet_mode_state = new_quiet_mode;
@@ -1035,24 +1358,24 @@ haier_protocol::HandlerError HonClimate::process_status_message_(const uint8_t *
     bool vertical_swing_supported = swing_modes.count(CLIMATE_SWING_VERTICAL);
     bool horizontal_swing_supported = swing_modes.count(CLIMATE_SWING_HORIZONTAL);
     if (horizontal_swing_supported &&
-        (packet.control.horizontal_swing_mode == (uint8_t) hon_protocol::HorizontalSwingMode::AUTO)) {
+        (control.horizontal_swing_mode() == (uint8_t) hon_protocol::HorizontalSwingMode::AUTO)) {
       if (vertical_swing_supported &&
-          (packet.control.vertical_swing_mode == (uint8_t) hon_protocol::VerticalSwingMode::AUTO)) {
+          (control.vertical_swing_mode() == (uint8_t) hon_protocol::VerticalSwingMode::AUTO)) {
         this->swing_mode = CLIMATE_SWING_BOTH;
       } else {
         this->swing_mode = CLIMATE_SWING_HORIZONTAL;
       }
     } else {
       if (vertical_swing_supported &&
-          (packet.control.vertical_swing_mode == (uint8_t) hon_protocol::VerticalSwingMode::AUTO)) {
+          (control.vertical_swing_mode() == (uint8_t) hon_protocol::VerticalSwingMode::AUTO)) {
         this->swing_mode = CLIMATE_SWING_VERTICAL;
       } else {
         this->swing_mode = CLIMATE_SWING_OFF;
       }
     }
     // Saving last known non auto mode for vertical and horizontal swing
-    this->current_vertical_swing_ = (hon_protocol::VerticalSwingMode) packet.control.vertical_swing_mode;
-    this->current_horizontal_swing_ = (hon_protocol::HorizontalSwingMode) packet.control.horizontal_swing_mode;
+    this->current_vertical_swing_ = (hon_protocol::VerticalSwingMode) control.vertical_swing_mode();
+    this->current_horizontal_swing_ = (hon_protocol::HorizontalSwingMode) control.horizontal_swing_mode();
     bool save_settings = ((this->current_vertical_swing_.value() != hon_protocol::VerticalSwingMode::AUTO) &&
                           (this->current_vertical_swing_.value() != hon_protocol::VerticalSwingMode::AUTO_SPECIAL) &&
                           (this->current_vertical_swing_.value() != this->settings_.last_vertiacal_swing)) ||
@@ -1067,39 +1390,37 @@ haier_protocol::HandlerError HonClimate::process_status_message_(const uint8_t *
   }
   this->last_valid_status_timestamp_ = std::chrono::steady_clock::now();
   if (should_publish) {
+    this->last_state_change_timestamp_ = this->last_valid_status_timestamp_;
     this->publish_state();
+    this->current_temperature_filter_.published(this->current_temperature, this->last_valid_status_timestamp_);
   }
   if (should_publish) {
     ESP_LOGI(TAG, "HVAC values changed");
   }
   int log_level = should_publish ? ESPHOME_LOG_LEVEL_INFO : ESPHOME_LOG_LEVEL_DEBUG;
-  esp_log_printf_(log_level, TAG, __LINE__, "HVAC Mode = 0x%X", packet.control.ac_mode);
-  esp_log_printf_(log_level, TAG, __LINE__, "Fan speed Status = 0x%X", packet.control.fan_mode);
-  esp_log_printf_(log_level, TAG, __LINE__, "Horizontal Swing Status = 0x%X", packet.control.horizontal_swing_mode);
-  esp_log_printf_(log_level, TAG, __LINE__, "Vertical Swing Status = 0x%X", packet.control.vertical_swing_mode);
-  esp_log_printf_(log_level, TAG, __LINE__, "Set Point Status = 0x%X", packet.control.set_point);
+  esp_log_printf_(log_level, TAG, __LINE__, "HVAC Mode = 0x%X", control.ac_mode());
+  esp_log_printf_(log_level, TAG, __LINE__, "Fan speed Status = 0x%X", control.fan_mode());
+  esp_log_printf_(log_level, TAG, __LINE__, "Horizontal Swing Status = 0x%X", control.horizontal_swing_mode());
+  esp_log_printf_(log_level, TAG, __LINE__, "Vertical Swing Status = 0x%X", control.vertical_swing_mode());
+  esp_log_printf_(log_level, TAG, __LINE__, "Set Point Status = 0x%X", control.set_point());
   return haier_protocol::HandlerError::HANDLER_OK;
 }
 
-void HonClimate::fill_control_messages_queue_() {
+bool HonClimate::fill_control_messages_queue_() {
   if (!this->current_hvac_settings_.valid && !this->force_send_control_)
-    return;
-  this->clear_control_messages_queue_();
+    return true;
+  bool queued = true;
   HvacSettings climate_control;
   climate_control = this->current_hvac_settings_;
   // Beeper command
   {
-    this->control_messages_queue_.emplace(haier_protocol::FrameType::CONTROL,
-                                          (uint16_t) hon_protocol::SubcommandsControl::SET_SINGLE_PARAMETER +
-                                              (uint8_t) hon_protocol::DataParameters::BEEPER_STATUS,
-                                          this->get_beeper_state() ? ZERO_BUF : ONE_BUF, 2);
+    queued &= this->control_queue_.push_parameter(hon_protocol::DataParameters::BEEPER_STATUS,
+                                                  this->get_beeper_state() ? 0 : 1);
   }
   // Health mode
   {
-    this->control_messages_queue_.emplace(haier_protocol::FrameType::CONTROL,
-                                          (uint16_t) hon_protocol::SubcommandsControl::SET_SINGLE_PARAMETER +
-                                              (uint8_t) hon_protocol::DataParameters::HEALTH_MODE,
-                                          this->get_health_mode() ? ONE_BUF : ZERO_BUF, 2);
+    queued &= this->control_queue_.push_parameter(hon_protocol::DataParameters::HEALTH_MODE,
+                                                  this->get_health_mode() ? 1 : 0);
     this->health_mode_ = (SwitchState) ((uint8_t) this->health_mode_ & 0b01);
   }
   // Climate mode
@@ -1117,46 +1438,31 @@ void HonClimate::fill_control_messages_queue_() {
       case CLIMATE_MODE_HEAT_COOL:
         new_power = true;
         buffer[1] = (uint8_t) hon_protocol::ConditioningMode::AUTO;
-        this->control_messages_queue_.emplace(haier_protocol::FrameType::CONTROL,
-                                              (uint16_t) hon_protocol::SubcommandsControl::SET_SINGLE_PARAMETER +
-                                                  (uint8_t) hon_protocol::DataParameters::AC_MODE,
-                                              buffer, 2);
+        queued &= this->control_queue_.push_parameter(hon_protocol::DataParameters::AC_MODE, buffer[1]);
         fan_mode_buf[1] = this->other_modes_fan_speed_;
         break;
       case CLIMATE_MODE_HEAT:
         new_power = true;
         buffer[1] = (uint8_t) hon_protocol::ConditioningMode::HEAT;
-        this->control_messages_queue_.emplace(haier_protocol::FrameType::CONTROL,
-                                              (uint16_t) hon_protocol::SubcommandsControl::SET_SINGLE_PARAMETER +
-                                                  (uint8_t) hon_protocol::DataParameters::AC_MODE,
-                                              buffer, 2);
+        queued &= this->control_queue_.push_parameter(hon_protocol::DataParameters::AC_MODE, buffer[1]);
         fan_mode_buf[1] = this->other_modes_fan_speed_;
         break;
       case CLIMATE_MODE_DRY:
         new_power = true;
         buffer[1] = (uint8_t) hon_protocol::ConditioningMode::DRY;
-        this->control_messages_queue_.emplace(haier_protocol::FrameType::CONTROL,
-                                              (uint16_t) hon_protocol::SubcommandsControl::SET_SINGLE_PARAMETER +
-                                                  (uint8_t) hon_protocol::DataParameters::AC_MODE,
-                                              buffer, 2);
+        queued &= this->control_queue_.push_parameter(hon_protocol::DataParameters::AC_MODE, buffer[1]);
         fan_mode_buf[1] = this->other_modes_fan_speed_;
         break;
       case CLIMATE_MODE_FAN_ONLY:
         new_power = true;
         buffer[1] = (uint8_t) hon_protocol::ConditioningMode::FAN;
-        this->control_messages_queue_.emplace(haier_protocol::FrameType::CONTROL,
-                                              (uint16_t) hon_protocol::SubcommandsControl::SET_SINGLE_PARAMETER +
-                                                  (uint8_t) hon_protocol::DataParameters::AC_MODE,
-                                              buffer, 2);
+        queued &= this->control_queue_.push_parameter(hon_protocol::DataParameters::AC_MODE, buffer[1]);
         fan_mode_buf[1] = this->other_modes_fan_speed_;  // Auto doesn't work in fan only mode
         break;
       case CLIMATE_MODE_COOL:
         new_power = true;
         buffer[1] = (uint8_t) hon_protocol::ConditioningMode::COOL;
-        this->control_messages_queue_.emplace(haier_protocol::FrameType::CONTROL,
-                                              (uint16_t) hon_protocol::SubcommandsControl::SET_SINGLE_PARAMETER +
-                                                  (uint8_t) hon_protocol::DataParameters::AC_MODE,
-                                              buffer, 2);
+        queued &= this->control_queue_.push_parameter(hon_protocol::DataParameters::AC_MODE, buffer[1]);
         fan_mode_buf[1] = this->other_modes_fan_speed_;
         break;
       default:
@@ -1166,10 +1472,7 @@ void HonClimate::fill_control_messages_queue_() {
   }
   // Climate power
   {
-    this->control_messages_queue_.emplace(haier_protocol::FrameType::CONTROL,
-                                          (uint16_t) hon_protocol::SubcommandsControl::SET_SINGLE_PARAMETER +
-                                              (uint8_t) hon_protocol::DataParameters::AC_POWER,
-                                          new_power ? ONE_BUF : ZERO_BUF, 2);
+    queued &= this->control_queue_.push_parameter(hon_protocol::DataParameters::AC_POWER, new_power ? 1 : 0);
   }
   // CLimate preset
   {
@@ -1211,32 +1514,20 @@ void HonClimate::fill_control_messages_queue_() {
     }
     auto presets = this->traits_.get_supported_presets();
     if (quiet_mode_buf[1] != 0xFF) {
-      this->control_messages_queue_.emplace(haier_protocol::FrameType::CONTROL,
-                                            (uint16_t) hon_protocol::SubcommandsControl::SET_SINGLE_PARAMETER +
-                                                (uint8_t) hon_protocol::DataParameters::QUIET_MODE,
-                                            quiet_mode_buf, 2);
+      queued &= this->control_queue_.push_parameter(hon_protocol::DataParameters::QUIET_MODE, quiet_mode_buf[1]);
     }
     if ((fast_mode_buf[1] != 0xFF) && presets.count(climate::ClimatePreset::CLIMATE_PRESET_BOOST)) {
-      this->control_messages_queue_.emplace(haier_protocol::FrameType::CONTROL,
-                                            (uint16_t) hon_protocol::SubcommandsControl::SET_SINGLE_PARAMETER +
-                                                (uint8_t) hon_protocol::DataParameters::FAST_MODE,
-                                            fast_mode_buf, 2);
+      queued &= this->control_queue_.push_parameter(hon_protocol::DataParameters::FAST_MODE, fast_mode_buf[1]);
     }
     if ((away_mode_buf[1] != 0xFF) && presets.count(climate::ClimatePreset::CLIMATE_PRESET_AWAY)) {
-      this->control_messages_queue_.emplace(haier_protocol::FrameType::CONTROL,
-                                            (uint16_t) hon_protocol::SubcommandsControl::SET_SINGLE_PARAMETER +
-                                                (uint8_t) hon_protocol::DataParameters::TEN_DEGREE,
-                                            away_mode_buf, 2);
+      queued &= this->control_queue_.push_parameter(hon_protocol::DataParameters::TEN_DEGREE, away_mode_buf[1]);
     }
   }
   // Target temperature
   if (climate_control.target_temperature.has_value() && (this->mode != ClimateMode::CLIMATE_MODE_FAN_ONLY)) {
     uint8_t buffer[2] = {0x00, 0x00};
     buffer[1] = ((uint8_t) climate_control.target_temperature.value()) - 16;
-    this->control_messages_queue_.emplace(haier_protocol::FrameType::CONTROL,
-                                          (uint16_t) hon_protocol::SubcommandsControl::SET_SINGLE_PARAMETER +
-                                              (uint8_t) hon_protocol::DataParameters::SET_POINT,
-                                          buffer, 2);
+    queued &= this->control_queue_.push_parameter(hon_protocol::DataParameters::SET_POINT, buffer[1]);
   }
   // Vertical swing mode
   if (climate_control.swing_mode.has_value()) {
@@ -1256,14 +1547,10 @@ void HonClimate::fill_control_messages_queue_() {
       case CLIMATE_SWING_BOTH:
         break;
     }
-    this->control_messages_queue_.emplace(haier_protocol::FrameType::CONTROL,
-                                          (uint16_t) hon_protocol::SubcommandsControl::SET_SINGLE_PARAMETER +
-                                              (uint8_t) hon_protocol::DataParameters::HORIZONTAL_SWING_MODE,
-                                          horizontal_swing_buf, 2);
-    this->control_messages_queue_.emplace(haier_protocol::FrameType::CONTROL,
-                                          (uint16_t) hon_protocol::SubcommandsControl::SET_SINGLE_PARAMETER +
-                                              (uint8_t) hon_protocol::DataParameters::VERTICAL_SWING_MODE,
-                                          vertical_swing_buf, 2);
+    queued &= this->control_queue_.push_parameter(hon_protocol::DataParameters::HORIZONTAL_SWING_MODE,
+                                                  horizontal_swing_buf[1]);
+    queued &= this->control_queue_.push_parameter(hon_protocol::DataParameters::VERTICAL_SWING_MODE,
+                                                  vertical_swing_buf[1]);
   }
   // Fan mode
   if (climate_control.fan_mode.has_value()) {
@@ -1286,35 +1573,89 @@ void HonClimate::fill_control_messages_queue_() {
         break;
     }
     if (fan_mode_buf[1] != 0xFF) {
-      this->control_messages_queue_.emplace(haier_protocol::FrameType::CONTROL,
-                                            (uint16_t) hon_protocol::SubcommandsControl::SET_SINGLE_PARAMETER +
-                                                (uint8_t) hon_protocol::DataParameters::FAN_MODE,
-                                            fan_mode_buf, 2);
+      queued &= this->control_queue_.push_parameter(hon_protocol::DataParameters::FAN_MODE, fan_mode_buf[1]);
     }
   }
+  return queued;
 }
 
-void HonClimate::clear_control_messages_queue_() {
-  while (!this->control_messages_queue_.empty())
-    this->control_messages_queue_.pop();
+void HonClimate::clear_control_messages_queue_() { this->control_queue_.clear(); }
+
+bool HonClimate::fill_auto_control_queue_(const uint8_t *control_packet, const uint8_t *changed_fields,
+                                          bool &changed) {
+  const uint8_t *status = this->last_status_message_;
+  // Only fields set from user settings are compared, other differences (cleared flags byte, beeper flag) come
+  // from the group packet preparation and are not changes of AC state
+  auto is_changed = [control_packet, changed_fields, status](const PacketField &field) {
+    return ((changed_fields[field.offset] & field.mask()) != 0) && (field.get(control_packet) != field.get(status));
+  };
+  // Changes outside of the single parameter fields can be done only with the group command
+  bool group_required = false;
+  for (size_t i = 0; i < this->real_control_packet_size_; i++) {
+    uint8_t single_parameters_mask = 0;
+    for (const auto &entry : SINGLE_PARAMETER_FIELDS) {
+      if (entry.field.offset == i)
+        single_parameters_mask |= entry.field.mask();
+    }
+    if (((control_packet[i] ^ status[i]) & changed_fields[i] & ~single_parameters_mask) != 0) {
+      group_required = true;
+      break;
+    }
+  }
+  size_t changes = 0;
+  for (const auto &entry : SINGLE_PARAMETER_FIELDS) {
+    if (is_changed(entry.field))
+      changes++;
+  }
+  changed = group_required || (changes > 0);
+  if (!changed)
+    return true;
+  // Every command is answered with the full status, so the cost of each round trip is request + answer
+  size_t answer_size = FRAME_OVERHEAD_SIZE + 2 + this->status_message_header_size_ + this->real_control_packet_size_ +
+                       this->real_sensors_packet_size_;
+  size_t group_cost = FRAME_OVERHEAD_SIZE + 2 + this->real_control_packet_size_ + answer_size;
+  // Single parameter commands start with beeper command like SET_SINGLE_PARAMETER method does
+  size_t single_cost = (changes + 1) * (FRAME_OVERHEAD_SIZE + 2 + 2 + answer_size);
+  if (group_required || (group_cost <= single_cost)) {
+    ESP_LOGD(TAG, "Auto control method: group parameters (%zu changes, %zu bytes vs %zu bytes)", changes, group_cost,
+             single_cost);
+    if (!this->control_queue_.push_group(control_packet, this->real_control_packet_size_))
+      return false;
+    this->auto_group_controls_++;
+  } else {
+    ESP_LOGD(TAG, "Auto control method: single parameters (%zu changes, %zu bytes vs %zu bytes)", changes,
+             single_cost, group_cost);
+    if (!this->control_queue_.push_parameter(hon_protocol::DataParameters::BEEPER_STATUS,
+                                             this->get_beeper_state() ? 0 : 1))
+      return false;
+    for (const auto &entry : SINGLE_PARAMETER_FIELDS) {
+      // Beeper field is never marked as changed, it is sent first
+      if (is_changed(entry.field) &&
+          !this->control_queue_.push_parameter(entry.parameter, entry.field.get(control_packet)))
+        return false;
+    }
+    this->auto_single_controls_++;
+  }
+  return true;
 }
 
 bool HonClimate::prepare_pending_action() {
+  namespace fields = hon_protocol::control_fields;
   auto &action_request = this->action_request_.value();  // NOLINT(bugprone-unchecked-optional-access)
   switch (action_request.action) {
     case ActionRequest::START_SELF_CLEAN:
-      if (this->control_method_ == HonControlMethod::SET_GROUP_PARAMETERS) {
+      if ((this->control_method_ == HonControlMethod::SET_GROUP_PARAMETERS) ||
+          (this->control_method_ == HonControlMethod::AUTO)) {
         uint8_t control_out_buffer[haier_protocol::MAX_FRAME_SIZE];
-        memcpy(control_out_buffer, this->last_status_message_.get(), this->real_control_packet_size_);
-        hon_protocol::HaierPacketControl *out_data = (hon_protocol::HaierPacketControl *) control_out_buffer;
-        out_data->self_cleaning_status = 1;
-        out_data->steri_clean = 0;
-        out_data->set_point = 0x06;
-        out_data->vertical_swing_mode = (uint8_t) hon_protocol::VerticalSwingMode::CENTER;
-        out_data->horizontal_swing_mode = (uint8_t) hon_protocol::HorizontalSwingMode::CENTER;
-        out_data->ac_power = 1;
-        out_data->ac_mode = (uint8_t) hon_protocol::ConditioningMode::DRY;
-        out_data->light_status = 0;
+        memcpy(control_out_buffer, this->last_status_message_, this->real_control_packet_size_);
+        fields::SELF_CLEANING_STATUS.set(control_out_buffer, 1);
+        fields::STERI_CLEAN.set(control_out_buffer, 0);
+        fields::SET_POINT.set(control_out_buffer, 0x06);
+        fields::VERTICAL_SWING_MODE.set(control_out_buffer, (uint8_t) hon_protocol::VerticalSwingMode::CENTER);
+        fields::HORIZONTAL_SWING_MODE.set(control_out_buffer, (uint8_t) hon_protocol::HorizontalSwingMode::CENTER);
+        fields::AC_POWER.set(control_out_buffer, 1);
+        fields::AC_MODE.set(control_out_buffer, (uint8_t) hon_protocol::ConditioningMode::DRY);
+        fields::LIGHT_STATUS.set(control_out_buffer, 0);
         action_request.message = haier_protocol::HaierMessage(
             haier_protocol::FrameType::CONTROL, (uint16_t) hon_protocol::SubcommandsControl::SET_GROUP_PARAMETERS,
             control_out_buffer, this->real_control_packet_size_);
@@ -1331,18 +1672,18 @@ bool HonClimate::prepare_pending_action() {
         return false;
       }
     case ActionRequest::START_STERI_CLEAN:
-      if (this->control_method_ == HonControlMethod::SET_GROUP_PARAMETERS) {
+      if ((this->control_method_ == HonControlMethod::SET_GROUP_PARAMETERS) ||
+          (this->control_method_ == HonControlMethod::AUTO)) {
         uint8_t control_out_buffer[haier_protocol::MAX_FRAME_SIZE];
-        memcpy(control_out_buffer, this->last_status_message_.get(), this->real_control_packet_size_);
-        hon_protocol::HaierPacketControl *out_data = (hon_protocol::HaierPacketControl *) control_out_buffer;
-        out_data->self_cleaning_status = 0;
-        out_data->steri_clean = 1;
-        out_data->set_point = 0x06;
-        out_data->vertical_swing_mode = (uint8_t) hon_protocol::VerticalSwingMode::CENTER;
-        out_data->horizontal_swing_mode = (uint8_t) hon_protocol::HorizontalSwingMode::CENTER;
-        out_data->ac_power = 1;
-        out_data->ac_mode = (uint8_t) hon_protocol::ConditioningMode::DRY;
-        out_data->light_status = 0;
+        memcpy(control_out_buffer, this->last_status_message_, this->real_control_packet_size_);
+        fields::SELF_CLEANING_STATUS.set(control_out_buffer, 0);
+        fields::STERI_CLEAN.set(control_out_buffer, 1);
+        fields::SET_POINT.set(control_out_buffer, 0x06);
+        fields::VERTICAL_SWING_MODE.set(control_out_buffer, (uint8_t) hon_protocol::VerticalSwingMode::CENTER);
+        fields::HORIZONTAL_SWING_MODE.set(control_out_buffer, (uint8_t) hon_protocol::HorizontalSwingMode::CENTER);
+        fields::AC_POWER.set(control_out_buffer, 1);
+        fields::AC_MODE.set(control_out_buffer, (uint8_t) hon_protocol::ConditioningMode::DRY);
+        fields::LIGHT_STATUS.set(control_out_buffer, 0);
         action_request.message = haier_protocol::HaierMessage(
             haier_protocol::FrameType::CONTROL, (uint16_t) hon_protocol::SubcommandsControl::SET_GROUP_PARAMETERS,
             control_out_buffer, this->real_control_packet_size_);
@@ -1360,22 +1701,32 @@ bool HonClimate::prepare_pending_action() {
 void HonClimate::process_protocol_reset() {
   HaierClimateBase::process_protocol_reset();
 #ifdef USE_SENSOR
-  for (auto &sub_sensor : this->sub_sensors_) {
-    if ((sub_sensor != nullptr) && sub_sensor->has_state())
-      sub_sensor->publish_state(NAN);
+  for (size_t i = 0; i < (size_t) SubSensorType::SUB_SENSOR_TYPE_COUNT; i++) {
+    // Energy is still known without communication with AC
+    if ((i == (size_t) SubSensorType::ENERGY) || (i == (size_t) SubSensorType::DAILY_ENERGY))
+      continue;
+    if ((this->sub_sensors_[i] != nullptr) && this->sub_sensors_[i]->has_state())
+      this->sub_sensors_[i]->publish_state(NAN);
+    this->sub_sensor_filters_[i].reset();
   }
+  this->energy_meter_.reset_samples();
 #endif  // USE_SENSOR
   this->got_valid_outdoor_temp_ = false;
-  this->hvac_hardware_info_.reset();
-  this->last_status_message_.reset(nullptr);
+  this->compressor_ramping_ = false;
+  // Keep device information for the fast start
+  if (!this->fast_start_)
+    this->hvac_hardware_info_.reset();
+  this->last_status_message_size_ = 0;
 }
 
-bool HonClimate::should_get_big_data_() {
-  if (this->big_data_sensors_ > 0) {
-    this->big_data_counter_ = (this->big_data_counter_ + 1) % 3;
-    return this->big_data_counter_ == 1;
-  }
-  return false;
+bool HonClimate::is_transient_state_() const { return this->compressor_ramping_; }
+
+bool HonClimate::has_cached_device_info_() const { return this->hvac_hardware_info_.has_value(); }
+
+bool HonClimate::is_big_data_request_due_(std::chrono::steady_clock::time_point now) const {
+  return (this->big_data_sensors_ > 0) &&
+         (std::chrono::duration_cast<std::chrono::milliseconds>(now - this->last_big_data_request_).count() >=
+          this->big_data_interval_ms_);
 }
 
 }  // namespace haier
@@ -1,7 +1,6 @@
 #pragma once
 
 #include <chrono>
-#include <queue>
 #ifdef USE_SENSOR
 #include "esphome/components/sensor/sensor.h"
 #endif
@@ -14,8 +13,14 @@
 #ifdef USE_SWITCH
 #include "esphome/components/switch/switch.h"
 #endif
+#ifdef USE_TIME
+#include "esphome/components/time/real_time_clock.h"
+#endif
 #include "esphome/core/automation.h"
+#include "alarm_history.h"
+#include "energy_meter.h"
 #include "haier_base.h"
+#include "hon_control_queue.h"
 #include "hon_packet.h"
 
 namespace esphome {
@@ -27,7 +32,7 @@ enum class CleaningState : uint8_t {
   STERI_CLEAN = 2,
 };
 
-enum class HonControlMethod { MONITOR_ONLY = 0, SET_GROUP_PARAMETERS, SET_SINGLE_PARAMETER };
+enum class HonControlMethod { MONITOR_ONLY = 0, SET_GROUP_PARAMETERS, SET_SINGLE_PARAMETER, AUTO };
 
 struct HonSettings {
   hon_protocol::VerticalSwingMode last_vertiacal_swing{hon_protocol::VerticalSwingMode::CENTER};
@@ -36,6 +41,21 @@ struct HonSettings {
   bool quiet_mode_state{false};
 };
 
+// Negotiated device information stored in flash for warm restarts
+struct HonDeviceInfo {
+  bool valid;
+  char protocol_version[8];
+  char software_version[8];
+  char hardware_version[8];
+  char device_name[8];
+  uint8_t functions;
+  uint8_t control_packet_size;
+  uint8_t sensors_packet_size;
+  uint8_t status_message_header_size;
+  uint8_t control_packet_stored;  // Size of the last known control packet, 0 if there is no packet
+  uint8_t control_packet[MAX_CONTROL_PACKET_SIZE];
+};
+
 class HonClimate : public HaierClimateBase {
 #ifdef USE_SENSOR
  public:
@@ -53,14 +73,28 @@ class HonClimate : public HaierClimateBase {
     COMPRESSOR_FREQUENCY,
     COMPRESSOR_CURRENT,
     EXPANSION_VALVE_OPEN_DEGREE,
+    ENERGY,
+    DAILY_ENERGY,
     SUB_SENSOR_TYPE_COUNT,
     BIG_DATA_FRAME_SUB_SENSORS = INDOOR_COIL_TEMPERATURE,
   };
   void set_sub_sensor(SubSensorType type, sensor::Sensor *sens);
+  void set_sub_sensor_publish_filter(SubSensorType type, float deadband, uint32_t min_interval_ms,
+                                     uint32_t heartbeat_ms);
+#ifdef USE_TIME
+  void set_energy_time(time::RealTimeClock *time) { this->energy_time_ = time; };
+#endif
 
  protected:
   void update_sub_sensor_(SubSensorType type, float value);
+  bool is_energy_metering_enabled_() const;
+  void update_energy_meter_(float power_w);
   sensor::Sensor *sub_sensors_[(size_t) SubSensorType::SUB_SENSOR_TYPE_COUNT]{nullptr};
+  PublishFilter sub_sensor_filters_[(size_t) SubSensorType::SUB_SENSOR_TYPE_COUNT];
+  EnergyMeter energy_meter_;
+#ifdef USE_TIME
+  time::RealTimeClock *energy_time_{nullptr};
+#endif
 #endif
 #ifdef USE_BINARY_SENSOR
  public:
@@ -85,13 +119,24 @@ class HonClimate : public HaierClimateBase {
     CLEANING_STATUS = 0,
     PROTOCOL_VERSION,
     APPLIANCE_NAME,
+    ALARM_HISTORY,
     SUB_TEXT_SENSOR_TYPE_COUNT,
   };
   void set_sub_text_sensor(SubTextSensorType type, text_sensor::TextSensor *sens);
+#ifdef USE_TIME
+  void set_alarm_history_time(time::RealTimeClock *time) { this->alarm_history_time_ = time; };
+#endif
 
  protected:
-  void update_sub_text_sensor_(SubTextSensorType type, const std::string &value);
+  void update_sub_text_sensor_(SubTextSensorType type, const char *value);
+  bool is_alarm_history_enabled_() const;
+  void update_alarm_history_(uint64_t old_alarms, uint64_t new_alarms, bool check_new);
+  void publish_alarm_history_();
   text_sensor::TextSensor *sub_text_sensors_[(size_t) SubTextSensorType::SUB_TEXT_SENSOR_TYPE_COUNT]{nullptr};
+  AlarmHistory alarm_history_;
+#ifdef USE_TIME
+  time::RealTimeClock *alarm_history_time_{nullptr};
+#endif
 #endif
 #ifdef USE_SWITCH
  public:
@@ -116,7 +161,7 @@ class HonClimate : public HaierClimateBase {
   void set_vertical_airflow(hon_protocol::VerticalSwingMode direction);
   esphome::optional<hon_protocol::HorizontalSwingMode> get_horizontal_airflow() const;
   void set_horizontal_airflow(hon_protocol::HorizontalSwingMode direction);
-  std::string get_cleaning_status_text() const;
+  const char *get_cleaning_status_text() const;
   CleaningState get_cleaning_status() const;
   void start_self_cleaning();
   void start_steri_cleaning();
@@ -124,6 +169,8 @@ class HonClimate : public HaierClimateBase {
   void set_extra_sensors_packet_bytes_size(size_t size) { this->extra_sensors_packet_bytes_ = size; };
   void set_status_message_header_size(size_t size) { this->status_message_header_size_ = size; };
   void set_control_method(HonControlMethod method) { this->control_method_ = method; };
+  void set_big_data_interval(uint32_t interval_ms) { this->big_data_interval_ms_ = interval_ms; };
+  void set_alarm_status_interval(uint32_t interval_ms) { this->alarm_status_interval_ms_ = interval_ms; };
   template<typename F> void add_alarm_start_callback(F &&callback) {
     this->alarm_start_callback_.add(std::forward<F>(callback));
   }
@@ -131,6 +178,7 @@ class HonClimate : public HaierClimateBase {
     this->alarm_end_callback_.add(std::forward<F>(callback));
   }
   float get_active_alarm_count() const { return this->active_alarm_count_; }
+  void on_shutdown() override;
 
  protected:
   void set_handlers() override;
@@ -140,7 +188,9 @@ class HonClimate : public HaierClimateBase {
   void initialization() override;
   bool prepare_pending_action() override;
   void process_protocol_reset() override;
-  bool should_get_big_data_();
+  bool is_big_data_request_due_(std::chrono::steady_clock::time_point now) const;
+  bool is_transient_state_() const override;
+  bool has_cached_device_info_() const override;
 
   // Answers handlers
   haier_protocol::HandlerError get_device_version_answer_handler_(haier_protocol::FrameType request_type,
@@ -163,14 +213,25 @@ class HonClimate : public HaierClimateBase {
   // Helper functions
   haier_protocol::HandlerError process_status_message_(const uint8_t *packet, uint8_t size);
   void process_alarm_message_(const uint8_t *packet, uint8_t size, bool check_new);
-  void fill_control_messages_queue_();
+  // Adds SET_SINGLE_PARAMETER commands for current settings, unsent commands for the same parameters are replaced.
+  // Returns false if some commands didn't fit in the queue
+  bool fill_control_messages_queue_();
+  // Builds SET_GROUP_PARAMETERS packet from the last status and current settings. If changed_fields is not null,
+  // bits of the fields that are set from settings and switches are marked in it
+  void fill_control_packet_(uint8_t *control_out_buffer, uint8_t *changed_fields = nullptr);
+  // Queue changes of the marked control packet fields with the method that needs less data, changed is false if
+  // nothing changed. Returns false if commands didn't fit in the queue
+  bool fill_auto_control_queue_(const uint8_t *control_packet, const uint8_t *changed_fields, bool &changed);
   void clear_control_messages_queue_();
+  void apply_device_info_();
+  void store_control_packet_(const uint8_t *packet);
+  void invalidate_device_info_();
 
   struct HardwareInfo {
-    std::string protocol_version_;
-    std::string software_version_;
-    std::string hardware_version_;
-    std::string device_name_;
+    char protocol_version_[9];
+    char software_version_[9];
+    char hardware_version_[9];
+    char device_name_[9];
     bool functions_[5];
   };
 
@@ -186,17 +247,28 @@ class HonClimate : public HaierClimateBase {
   size_t real_control_packet_size_{sizeof(hon_protocol::HaierPacketControl)};
   int real_sensors_packet_size_{sizeof(hon_protocol::HaierPacketSensors) + 4};
   HonControlMethod control_method_;
-  std::queue<haier_protocol::HaierMessage> control_messages_queue_;
+  HonControlQueue control_queue_;
+  uint32_t auto_group_controls_{0};   // Change sets sent with SET_GROUP_PARAMETERS in AUTO mode
+  uint32_t auto_single_controls_{0};  // Change sets sent with SET_SINGLE_PARAMETER in AUTO mode
   CallbackManager<void(uint8_t, const char *)> alarm_start_callback_{};
   CallbackManager<void(uint8_t, const char *)> alarm_end_callback_{};
   float active_alarm_count_{NAN};
   std::chrono::steady_clock::time_point last_alarm_request_;
   int big_data_sensors_{0};
-  uint8_t big_data_counter_{0};
+  std::chrono::steady_clock::time_point last_big_data_request_;
+  uint32_t big_data_interval_ms_{15000};
+  uint32_t big_data_requests_count_{0};
+  uint32_t alarm_status_interval_ms_{600000};
+  uint8_t last_compressor_frequency_{0};
+  bool compressor_ramping_{false};
   esphome::optional<hon_protocol::VerticalSwingMode> current_vertical_swing_{};
   esphome::optional<hon_protocol::HorizontalSwingMode> current_horizontal_swing_{};
   HonSettings settings_{};
   ESPPreferenceObject hon_rtc_;
+  HonDeviceInfo device_info_{};
+  ESPPreferenceObject device_info_rtc_;
+  // Stored device information was used to skip the handshake, it is checked with GET_DEVICE_VERSION request later
+  bool device_info_check_pending_{false};
   SwitchState quiet_mode_state_{SwitchState::OFF};
 };
 
@@ -0,0 +1,79 @@
+#include <cstring>
+#include "hon_control_queue.h"
+
+namespace esphome {
+namespace haier {
+
+bool HonControlQueue::push_(uint16_t subcommand, uint16_t value) {
+  // Command that is already sent can't be replaced
+  for (size_t i = this->front_sent_ ? 1 : 0; i < this->count_; i++) {
+    Command &command = this->at_(i);
+    if (command.subcommand == subcommand) {
+      if (command.value != value) {
+        command.value = value;
+        this->coalesced_count_++;
+      }
+      return true;
+    }
+  }
+  // The same value is being sent already
+  if (this->front_sent_ && (this->at_(0).subcommand == subcommand) && (this->at_(0).value == value) &&
+      (subcommand != (uint16_t) hon_protocol::SubcommandsControl::SET_GROUP_PARAMETERS))
+    return true;
+  if (this->count_ >= CAPACITY)
+    return false;
+  this->at_(this->count_) = {subcommand, value};
+  this->count_++;
+  return true;
+}
+
+bool HonControlQueue::push_parameter(hon_protocol::DataParameters parameter, uint16_t value) {
+  return this->push_((uint16_t) hon_protocol::SubcommandsControl::SET_SINGLE_PARAMETER + (uint8_t) parameter, value);
+}
+
+bool HonControlQueue::push_group(const uint8_t *packet, size_t size) {
+  if (size > MAX_CONTROL_PACKET_SIZE)
+    return false;
+  if ((this->group_packet_size_ != 0) && this->front_sent_ &&
+      (this->at_(0).subcommand == (uint16_t) hon_protocol::SubcommandsControl::SET_GROUP_PARAMETERS))
+    // Packet buffer is used by the command that is waiting for answer
+    return false;
+  // Group command that is not sent yet is replaced
+  bool replaced = this->group_packet_size_ != 0;
+  if (!this->push_((uint16_t) hon_protocol::SubcommandsControl::SET_GROUP_PARAMETERS, 0))
+    return false;
+  if (replaced && ((size != this->group_packet_size_) || (memcmp(this->group_packet_, packet, size) != 0)))
+    this->coalesced_count_++;
+  memcpy(this->group_packet_, packet, size);
+  this->group_packet_size_ = size;
+  return true;
+}
+
+haier_protocol::HaierMessage HonControlQueue::get_front_message() const {
+  const Command &command = this->at_(0);
+  if (command.subcommand == (uint16_t) hon_protocol::SubcommandsControl::SET_GROUP_PARAMETERS)
+    return haier_protocol::HaierMessage(haier_protocol::FrameType::CONTROL, command.subcommand, this->group_packet_,
+                                        this->group_packet_size_);
+  const uint8_t buffer[2] = {(uint8_t) (command.value >> 8), (uint8_t) (command.value & 0xFF)};
+  return haier_protocol::HaierMessage(haier_protocol::FrameType::CONTROL, command.subcommand, buffer, 2);
+}
+
+void HonControlQueue::pop() {
+  if (this->count_ == 0)
+    return;
+  if (this->at_(0).subcommand == (uint16_t) hon_protocol::SubcommandsControl::SET_GROUP_PARAMETERS)
+    this->group_packet_size_ = 0;
+  this->head_ = (this->head_ + 1) % CAPACITY;
+  this->count_--;
+  this->front_sent_ = false;
+}
+
+void HonControlQueue::clear() {
+  this->head_ = 0;
+  this->count_ = 0;
+  this->front_sent_ = false;
+  this->group_packet_size_ = 0;
+}
+
+}  // namespace haier
+}  // namespace esphome
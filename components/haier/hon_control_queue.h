@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "haier_base.h"
+#include "hon_packet.h"
+// HaierProtocol
+#include <protocol/haier_protocol.h>
+
+namespace esphome {
+namespace haier {
+
+// Fixed capacity ring of hOn control commands.
+// SET_SINGLE_PARAMETER commands are stored as parameter ID and value, SET_GROUP_PARAMETERS command keeps
+// its control packet inline (only one group command can be queued). Messages are built only when sent.
+// If a new value for a parameter arrives before the queued one is sent, the queued value is replaced
+// (settings that come while commands are being sent are merged into the queue by HonClimate::process_phase).
+class HonControlQueue {
+ public:
+  // Enough for all parameters that can be set with SET_SINGLE_PARAMETER in one control cycle
+  static constexpr size_t CAPACITY = 16;
+  // Returns false if there is no space in the queue
+  bool push_parameter(hon_protocol::DataParameters parameter, uint16_t value);
+  bool push_group(const uint8_t *packet, size_t size);
+  bool empty() const { return this->count_ == 0; };
+  size_t size() const { return this->count_; };
+  haier_protocol::HaierMessage get_front_message() const;
+  // Front command is sent, it can't be changed anymore
+  void front_sent() { this->front_sent_ = this->count_ > 0; };
+  void pop();
+  void clear();
+  uint32_t get_coalesced_count() const { return this->coalesced_count_; };
+
+ protected:
+  struct Command {
+    uint16_t subcommand;
+    uint16_t value;
+  };
+  Command &at_(size_t index) { return this->commands_[(this->head_ + index) % CAPACITY]; };
+  const Command &at_(size_t index) const { return this->commands_[(this->head_ + index) % CAPACITY]; };
+  bool push_(uint16_t subcommand, uint16_t value);
+  Command commands_[CAPACITY];
+  size_t head_{0};
+  size_t count_{0};
+  bool front_sent_{false};
+  uint8_t group_packet_[MAX_CONTROL_PACKET_SIZE];
+  size_t group_packet_size_{0};
+  uint32_t coalesced_count_{0};
+};
+
+}  // namespace haier
+}  // namespace esphome
@@ -1,6 +1,9 @@
 ﻿#pragma once
 
 #include <cstdint>
+#include <cstring>
+#include "esphome/core/hal.h"
+#include "packet_view.h"
 
 namespace esphome {
 namespace haier {
@@ -176,6 +179,139 @@ struct HaierPacketBigData {
   uint8_t expansion_valve_open_degree[2];  // 0 - 4095
 };
 
+static_assert(sizeof(HaierPacketControl) == 10, "Unexpected HaierPacketControl size");
+static_assert(sizeof(HaierPacketSensors) == 18, "Unexpected HaierPacketSensors size");
+static_assert(sizeof(HaierPacketBigData) == 14, "Unexpected HaierPacketBigData size");
+
+// Field descriptors of the packets above, offsets are relative to the beginning of the packet.
+// Structures define packet sizes, descriptors are used to decode and encode fields.
+namespace control_fields {
+constexpr PacketField SET_POINT{0, 0, 8};
+constexpr PacketField VERTICAL_SWING_MODE{1, 0, 4};
+constexpr PacketField FAN_MODE{2, 0, 3};
+constexpr PacketField SPECIAL_MODE{2, 3, 2};
+constexpr PacketField AC_MODE{2, 5, 3};
+constexpr PacketField TEN_DEGREE{4, 0, 1};
+constexpr PacketField DISPLAY_STATUS{4, 1, 1};
+constexpr PacketField HALF_DEGREE{4, 2, 1};
+constexpr PacketField INTELLIGENCE_STATUS{4, 3, 1};
+constexpr PacketField PMV_STATUS{4, 4, 1};
+constexpr PacketField USE_FAHRENHEIT{4, 5, 1};
+constexpr PacketField STERI_CLEAN{4, 7, 1};
+constexpr PacketField AC_POWER{5, 0, 1};
+constexpr PacketField HEALTH_MODE{5, 1, 1};
+constexpr PacketField ELECTRIC_HEATING_STATUS{5, 2, 1};
+constexpr PacketField FAST_MODE{5, 3, 1};
+constexpr PacketField QUIET_MODE{5, 4, 1};
+constexpr PacketField SLEEP_MODE{5, 5, 1};
+constexpr PacketField LOCK_REMOTE{5, 6, 1};
+constexpr PacketField BEEPER_STATUS{5, 7, 1};
+constexpr PacketField TARGET_HUMIDITY{6, 0, 8};
+constexpr PacketField HORIZONTAL_SWING_MODE{7, 0, 3};
+constexpr PacketField HUMAN_SENSING_STATUS{7, 6, 2};
+constexpr PacketField CHANGE_FILTER{8, 0, 1};
+constexpr PacketField FRESH_AIR_STATUS{9, 0, 1};
+constexpr PacketField HUMIDIFICATION_STATUS{9, 1, 1};
+constexpr PacketField PM2P5_CLEANING_STATUS{9, 2, 1};
+constexpr PacketField CH2O_CLEANING_STATUS{9, 3, 1};
+constexpr PacketField SELF_CLEANING_STATUS{9, 4, 1};
+constexpr PacketField LIGHT_STATUS{9, 5, 1};
+constexpr PacketField ENERGY_SAVING_STATUS{9, 6, 1};
+constexpr PacketField CLEANING_TIME_STATUS{9, 7, 1};
+}  // namespace control_fields
+
+namespace sensors_fields {
+constexpr PacketField ROOM_TEMPERATURE{0, 0, 8};
+constexpr PacketField ROOM_HUMIDITY{1, 0, 8};
+constexpr PacketField OUTDOOR_TEMPERATURE{2, 0, 8};
+constexpr PacketField PM2P5_LEVEL{3, 0, 2};
+constexpr PacketField AIR_QUALITY{3, 2, 2};
+constexpr PacketField HUMAN_SENSING{3, 4, 2};
+constexpr PacketField AC_TYPE{3, 7, 1};
+constexpr PacketField ERROR_STATUS{4, 0, 8};
+constexpr PacketField OPERATION_SOURCE{5, 0, 2};
+constexpr PacketField OPERATION_MODE_HK{5, 2, 2};
+constexpr PacketField ERR_CONFIRMATION{5, 7, 1};
+}  // namespace sensors_fields
+
+namespace big_data_fields {
+constexpr PacketWord POWER{0};
+constexpr PacketField INDOOR_COIL_TEMPERATURE{2, 0, 8};
+constexpr PacketField OUTDOOR_OUT_AIR_TEMPERATURE{3, 0, 8};
+constexpr PacketField OUTDOOR_COIL_TEMPERATURE{4, 0, 8};
+constexpr PacketField OUTDOOR_IN_AIR_TEMPERATURE{5, 0, 8};
+constexpr PacketField OUTDOOR_DEFROST_TEMPERATURE{6, 0, 8};
+constexpr PacketField COMPRESSOR_FREQUENCY{7, 0, 8};
+constexpr PacketWord COMPRESSOR_CURRENT{8};
+constexpr PacketField OUTDOOR_FAN_STATUS{10, 0, 2};
+constexpr PacketField DEFROST_STATUS{10, 2, 2};
+constexpr PacketField COMPRESSOR_STATUS{11, 0, 2};
+constexpr PacketField INDOOR_FAN_STATUS{11, 2, 2};
+constexpr PacketField FOUR_WAY_VALVE_STATUS{11, 4, 2};
+constexpr PacketField INDOOR_ELECTRIC_HEATING_STATUS{11, 6, 2};
+constexpr PacketWord EXPANSION_VALVE_OPEN_DEGREE{12};
+}  // namespace big_data_fields
+
+// Zero-copy views of the packets above
+class HaierPacketControlView : public PacketView {
+ public:
+  using PacketView::PacketView;
+  explicit HaierPacketControlView(const PacketView &view) : PacketView(view) {}
+  uint8_t set_point() const { return this->get(control_fields::SET_POINT); };
+  uint8_t vertical_swing_mode() const { return this->get(control_fields::VERTICAL_SWING_MODE); };
+  uint8_t fan_mode() const { return this->get(control_fields::FAN_MODE); };
+  uint8_t special_mode() const { return this->get(control_fields::SPECIAL_MODE); };
+  uint8_t ac_mode() const { return this->get(control_fields::AC_MODE); };
+  bool ten_degree() const { return this->get(control_fields::TEN_DEGREE) != 0; };
+  bool display_status() const { return this->get(control_fields::DISPLAY_STATUS) != 0; };
+  bool half_degree() const { return this->get(control_fields::HALF_DEGREE) != 0; };
+  bool use_fahrenheit() const { return this->get(control_fields::USE_FAHRENHEIT) != 0; };
+  bool steri_clean() const { return this->get(control_fields::STERI_CLEAN) != 0; };
+  bool ac_power() const { return this->get(control_fields::AC_POWER) != 0; };
+  bool health_mode() const { return this->get(control_fields::HEALTH_MODE) != 0; };
+  bool fast_mode() const { return this->get(control_fields::FAST_MODE) != 0; };
+  bool quiet_mode() const { return this->get(control_fields::QUIET_MODE) != 0; };
+  bool sleep_mode() const { return this->get(control_fields::SLEEP_MODE) != 0; };
+  bool lock_remote() const { return this->get(control_fields::LOCK_REMOTE) != 0; };
+  bool beeper_status() const { return this->get(control_fields::BEEPER_STATUS) != 0; };
+  uint8_t target_humidity() const { return this->get(control_fields::TARGET_HUMIDITY); };
+  uint8_t horizontal_swing_mode() const { return this->get(control_fields::HORIZONTAL_SWING_MODE); };
+  bool self_cleaning_status() const { return this->get(control_fields::SELF_CLEANING_STATUS) != 0; };
+};
+
+class HaierPacketSensorsView : public PacketView {
+ public:
+  using PacketView::PacketView;
+  explicit HaierPacketSensorsView(const PacketView &view) : PacketView(view) {}
+  uint8_t room_temperature() const { return this->get(sensors_fields::ROOM_TEMPERATURE); };
+  uint8_t room_humidity() const { return this->get(sensors_fields::ROOM_HUMIDITY); };
+  uint8_t outdoor_temperature() const { return this->get(sensors_fields::OUTDOOR_TEMPERATURE); };
+  uint8_t error_status() const { return this->get(sensors_fields::ERROR_STATUS); };
+};
+
+class HaierPacketBigDataView : public PacketView {
+ public:
+  using PacketView::PacketView;
+  explicit HaierPacketBigDataView(const PacketView &view) : PacketView(view) {}
+  uint16_t power() const { return this->get(big_data_fields::POWER); };
+  uint8_t indoor_coil_temperature() const { return this->get(big_data_fields::INDOOR_COIL_TEMPERATURE); };
+  uint8_t outdoor_out_air_temperature() const { return this->get(big_data_fields::OUTDOOR_OUT_AIR_TEMPERATURE); };
+  uint8_t outdoor_coil_temperature() const { return this->get(big_data_fields::OUTDOOR_COIL_TEMPERATURE); };
+  uint8_t outdoor_in_air_temperature() const { return this->get(big_data_fields::OUTDOOR_IN_AIR_TEMPERATURE); };
+  uint8_t outdoor_defrost_temperature() const { return this->get(big_data_fields::OUTDOOR_DEFROST_TEMPERATURE); };
+  uint8_t compressor_frequency() const { return this->get(big_data_fields::COMPRESSOR_FREQUENCY); };
+  uint16_t compressor_current() const { return this->get(big_data_fields::COMPRESSOR_CURRENT); };
+  uint8_t outdoor_fan_status() const { return this->get(big_data_fields::OUTDOOR_FAN_STATUS); };
+  uint8_t defrost_status() const { return this->get(big_data_fields::DEFROST_STATUS); };
+  uint8_t compressor_status() const { return this->get(big_data_fields::COMPRESSOR_STATUS); };
+  uint8_t indoor_fan_status() const { return this->get(big_data_fields::INDOOR_FAN_STATUS); };
+  uint8_t four_way_valve_status() const { return this->get(big_data_fields::FOUR_WAY_VALVE_STATUS); };
+  uint8_t indoor_electric_heating_status() const {
+    return this->get(big_data_fields::INDOOR_ELECTRIC_HEATING_STATUS);
+  };
+  uint16_t expansion_valve_open_degree() const { return this->get(big_data_fields::EXPANSION_VALVE_OPEN_DEGREE); };
+};
+
 struct DeviceVersionAnswer {
   char protocol_version[8];
   char software_version[8];
@@ -199,7 +335,11 @@ enum class SubcommandsControl : uint16_t {
                                   // content: all values like in status packet)
 };
 
-const std::string HON_ALARM_MESSAGES[] = {
+// Longest alarm message with terminating zero
+constexpr size_t HON_ALARM_MESSAGE_SIZE = 52;
+
+// Alarm messages are kept in flash (PROGMEM on ESP8266), use get_alarm_message() to read them
+constexpr char HON_ALARM_MESSAGES[][HON_ALARM_MESSAGE_SIZE] PROGMEM = {
     "Outdoor module failure",
     "Outdoor defrost sensor failure",
     "Outdoor compressor exhaust sensor failure",
@@ -255,6 +395,21 @@ const std::string HON_ALARM_MESSAGES[] = {
 
 constexpr size_t HON_ALARM_COUNT = sizeof(HON_ALARM_MESSAGES) / sizeof(HON_ALARM_MESSAGES[0]);
 
+// Copy alarm message to the buffer of at least HON_ALARM_MESSAGE_SIZE bytes, returns the buffer
+inline const char *get_alarm_message(uint8_t alarm_code, char *buffer) {
+  if (alarm_code >= HON_ALARM_COUNT) {
+    strcpy(buffer, "Unknown");
+  } else {
+    const uint8_t *message = (const uint8_t *) HON_ALARM_MESSAGES[alarm_code];
+    for (size_t i = 0; i < HON_ALARM_MESSAGE_SIZE; i++) {
+      buffer[i] = (char) progmem_read_byte(message + i);
+      if (buffer[i] == 0)
+        break;
+    }
+  }
+  return buffer;
+}
+
 }  // namespace hon_protocol
 }  // namespace haier
 }  // namespace esphome
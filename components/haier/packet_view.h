@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace haier {
+
+// Bit field of a packet: byte offset, position of the least significant bit (bit 0 is the least
+// significant bit of the byte) and width in bits. Packet layouts are described with tables of these
+// descriptors, the same descriptors are used for decoding and encoding, so the result doesn't depend on
+// the compiler bitfield layout and compiles to shifts and masks on every platform.
+struct PacketField {
+  uint8_t offset;
+  uint8_t shift;
+  uint8_t width;
+  constexpr uint8_t value_mask() const { return (uint8_t) ((1u << this->width) - 1); };
+  constexpr uint8_t mask() const { return (uint8_t) (this->value_mask() << this->shift); };
+  constexpr uint8_t decode(uint8_t byte) const { return (byte >> this->shift) & this->value_mask(); };
+  constexpr uint8_t encode(uint8_t byte, uint8_t value) const {
+    return (byte & ~this->mask()) | ((value << this->shift) & this->mask());
+  };
+  uint8_t get(const uint8_t *packet) const { return this->decode(packet[this->offset]); };
+  void set(uint8_t *packet, uint8_t value) const { packet[this->offset] = this->encode(packet[this->offset], value); };
+};
+
+// Big endian 16-bit value of a packet
+struct PacketWord {
+  uint8_t offset;
+};
+
+// Read-only view over a part of a received frame, doesn't copy the data.
+// Reading outside of the view returns 0.
+class PacketView {
+ public:
+  PacketView() = default;
+  PacketView(const uint8_t *data, size_t size) : data_(data), size_((data != nullptr) ? size : 0) {}
+  const uint8_t *data() const { return this->data_; };
+  size_t size() const { return this->size_; };
+  bool contains(size_t offset, size_t size) const { return (offset <= this->size_) && (size <= this->size_ - offset); };
+  // Empty view if the requested part is out of bounds
+  PacketView sub_view(size_t offset, size_t size) const {
+    return this->contains(offset, size) ? PacketView(this->data_ + offset, size) : PacketView();
+  };
+  uint8_t get_byte(size_t offset) const { return (offset < this->size_) ? this->data_[offset] : 0; };
+  uint8_t get(const PacketField &field) const { return field.decode(this->get_byte(field.offset)); };
+  uint16_t get(const PacketWord &word) const { return this->get_uint16(word.offset); };
+  // Big endian 16-bit value
+  uint16_t get_uint16(size_t offset) const {
+    return (((uint16_t) this->get_byte(offset)) << 8) | this->get_byte(offset + 1);
+  };
+
+ protected:
+  const uint8_t *data_{nullptr};
+  size_t size_{0};
+};
+
+}  // namespace haier
+}  // namespace esphome
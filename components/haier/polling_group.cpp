@@ -0,0 +1,83 @@
+#include "esphome/core/log.h"
+#include "polling_group.h"
+
+namespace esphome {
+namespace haier {
+
+static const char *const TAG = "haier.polling_group";
+// Safety net, status request should be finished by answer or timeout much earlier
+constexpr uint32_t MAX_ACTIVE_TIME_MS = 15000;
+
+void PollingGroup::register_member(HaierClimateBase *member) {
+  if (this->find_member_(member) < 0)
+    this->members_.push_back({member, false});
+}
+
+int PollingGroup::find_member_(const HaierClimateBase *member) const {
+  for (size_t i = 0; i < this->members_.size(); i++) {
+    if (this->members_[i].climate == member)
+      return i;
+  }
+  return -1;
+}
+
+bool PollingGroup::acquire(HaierClimateBase *member, std::chrono::steady_clock::time_point now) {
+  int index = this->find_member_(member);
+  if (index < 0)
+    return true;
+  if (this->active_member_ == index)
+    return true;
+  this->members_[index].waiting = true;
+  if (this->active_member_ >= 0) {
+    if (std::chrono::duration_cast<std::chrono::milliseconds>(now - this->active_since_).count() < MAX_ACTIVE_TIME_MS)
+      return false;
+    ESP_LOGW(TAG, "Group %s: member %d didn't finish status request, skipping it", this->name_, this->active_member_);
+    this->active_member_ = -1;
+    this->last_release_ = now;
+  }
+  if (std::chrono::duration_cast<std::chrono::milliseconds>(now - this->last_release_).count() < this->poll_gap_ms_)
+    return false;
+  // Looking for the first waiting member starting from the one after the last served
+  const size_t members_count = this->members_.size();
+  for (size_t i = 0; i < members_count; i++) {
+    size_t candidate = ((size_t) (this->last_served_ + 1) + i) % members_count;
+    if (this->members_[candidate].waiting) {
+      if (candidate != (size_t) index)
+        return false;
+      break;
+    }
+  }
+  if (this->last_served_ < 0) {
+    // First status request of the group
+    this->cycle_start_ = now;
+  } else if (index <= this->last_served_) {
+    // Wrapped around, one round-robin cycle finished
+    this->last_cycle_time_ms_ =
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - this->cycle_start_).count();
+    if (this->last_cycle_time_ms_ > this->max_cycle_time_ms_)
+      this->max_cycle_time_ms_ = this->last_cycle_time_ms_;
+    this->cycle_start_ = now;
+  }
+  this->members_[index].waiting = false;
+  this->active_member_ = index;
+  this->active_since_ = now;
+  this->last_served_ = index;
+  return true;
+}
+
+void PollingGroup::release(HaierClimateBase *member, std::chrono::steady_clock::time_point now) {
+  int index = this->find_member_(member);
+  if ((index >= 0) && (index == this->active_member_)) {
+    this->active_member_ = -1;
+    this->last_release_ = now;
+  }
+}
+
+void PollingGroup::withdraw(HaierClimateBase *member) {
+  int index = this->find_member_(member);
+  if (index >= 0)
+    this->members_[index].waiting = false;
+}
+
+}  // namespace haier
+}  // namespace esphome
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+namespace esphome {
+namespace haier {
+
+class HaierClimateBase;
+
+// Round-robin arbiter for status polling of several appliances driven by the same controller.
+// Only status requests go through the group, control and action commands are sent immediately.
+class PollingGroup {
+ public:
+  explicit PollingGroup(const char *name) : name_(name) {}
+  PollingGroup(const PollingGroup &) = delete;
+  PollingGroup &operator=(const PollingGroup &) = delete;
+  void register_member(HaierClimateBase *member);
+  // Should be called by a member when its status request is due, returns true if member can send it now
+  bool acquire(HaierClimateBase *member, std::chrono::steady_clock::time_point now);
+  // Member left the status request phase: it is called from set_phase() after the answer to the status
+  // request was processed or the request timed out, not when the request is sent
+  void release(HaierClimateBase *member, std::chrono::steady_clock::time_point now);
+  // Member doesn't need status request anymore (control, action, reset, etc.)
+  void withdraw(HaierClimateBase *member);
+  void set_poll_gap(uint32_t gap) { this->poll_gap_ms_ = gap; };
+  const char *get_name() const { return this->name_; };
+  size_t get_members_count() const { return this->members_.size(); };
+  uint32_t get_last_cycle_time() const { return this->last_cycle_time_ms_; };
+  uint32_t get_max_cycle_time() const { return this->max_cycle_time_ms_; };
+
+ protected:
+  struct Member {
+    HaierClimateBase *climate;
+    bool waiting;
+  };
+  int find_member_(const HaierClimateBase *member) const;
+  const char *name_;
+  std::vector<Member> members_;
+  int active_member_{-1};
+  // Last member that got the slot, -1 until the first one
+  int last_served_{-1};
+  uint32_t poll_gap_ms_{100};
+  uint32_t last_cycle_time_ms_{0};
+  uint32_t max_cycle_time_ms_{0};
+  std::chrono::steady_clock::time_point active_since_;
+  std::chrono::steady_clock::time_point last_release_;
+  std::chrono::steady_clock::time_point cycle_start_;
+};
+
+}  // namespace haier
+}  // namespace esphome
@@ -0,0 +1,99 @@
+#include <cmath>
+#include "protocol_statistics.h"
+
+namespace esphome {
+namespace haier {
+
+// Haier frame: 0xFF 0xFF, length, flags, 5 reserved bytes, frame type, ...
+constexpr size_t FRAME_TYPE_OFFSET = 9;
+constexpr uint32_t HISTOGRAM_LIMITS_MS[ProtocolStatistics::HISTOGRAM_BUCKETS - 1] = {50, 100, 200, 500, 1000};
+
+uint32_t ProtocolStatistics::get_histogram_limit(size_t bucket) {
+  return bucket < ProtocolStatistics::HISTOGRAM_BUCKETS - 1 ? HISTOGRAM_LIMITS_MS[bucket] : 0;
+}
+
+ProtocolStatistics::FrameStatistics *ProtocolStatistics::get_frame_(haier_protocol::FrameType type) {
+  for (size_t i = 0; i < this->frame_types_count_; i++) {
+    if (this->frames_[i].frame_type == type)
+      return &this->frames_[i];
+  }
+  if (this->frame_types_count_ >= MAX_FRAME_TYPES)
+    return nullptr;
+  FrameStatistics &stats = this->frames_[this->frame_types_count_++];
+  stats = FrameStatistics{};
+  stats.frame_type = type;
+  return &stats;
+}
+
+void ProtocolStatistics::request_queued(haier_protocol::FrameType type, std::chrono::steady_clock::time_point now) {
+  FrameStatistics *stats = this->get_frame_(type);
+  if (stats != nullptr)
+    stats->requests++;
+  this->waiting_answer_ = true;
+  this->pending_type_ = type;
+  this->pending_attempts_ = 0;
+  this->last_attempt_ = now;
+}
+
+void ProtocolStatistics::frame_written(const uint8_t *data, size_t size, std::chrono::steady_clock::time_point now) {
+  if (!this->waiting_answer_ || (size <= FRAME_TYPE_OFFSET) || (data[0] != 0xFF) || (data[1] != 0xFF))
+    return;
+  if ((haier_protocol::FrameType) data[FRAME_TYPE_OFFSET] != this->pending_type_)
+    return;
+  if (++this->pending_attempts_ > 1) {
+    // Previous attempt didn't get an answer in time, the request was repeated
+    FrameStatistics *stats = this->get_frame_(this->pending_type_);
+    if (stats != nullptr)
+      stats->retries++;
+    this->total_retries_++;
+  }
+  this->last_attempt_ = now;
+}
+
+void ProtocolStatistics::answer_received(haier_protocol::FrameType request_type,
+                                         std::chrono::steady_clock::time_point now) {
+  if (!this->waiting_answer_ || (request_type != this->pending_type_))
+    return;
+  this->waiting_answer_ = false;
+  uint32_t answer_time = std::chrono::duration_cast<std::chrono::milliseconds>(now - this->last_attempt_).count();
+  this->period_answers_++;
+  this->period_answer_time_ms_ += answer_time;
+  FrameStatistics *stats = this->get_frame_(request_type);
+  if (stats == nullptr)
+    return;
+  if ((stats->answers == 0) || (answer_time < stats->min_answer_time_ms))
+    stats->min_answer_time_ms = answer_time;
+  if (answer_time > stats->max_answer_time_ms)
+    stats->max_answer_time_ms = answer_time;
+  stats->answers++;
+  stats->total_answer_time_ms += answer_time;
+  size_t bucket = 0;
+  while ((bucket < HISTOGRAM_BUCKETS - 1) && (answer_time >= HISTOGRAM_LIMITS_MS[bucket]))
+    bucket++;
+  stats->histogram[bucket]++;
+}
+
+void ProtocolStatistics::answer_timeout(haier_protocol::FrameType request_type) {
+  this->waiting_answer_ = false;
+  this->total_timeouts_++;
+  FrameStatistics *stats = this->get_frame_(request_type);
+  if (stats != nullptr)
+    stats->timeouts++;
+}
+
+void ProtocolStatistics::status_processed(uint32_t time_us) {
+  this->status_processed_count_++;
+  this->total_status_processing_us_ += time_us;
+  if (time_us > this->max_status_processing_us_)
+    this->max_status_processing_us_ = time_us;
+}
+
+float ProtocolStatistics::pop_period_average_answer_time() {
+  float result = (this->period_answers_ > 0) ? (float) this->period_answer_time_ms_ / this->period_answers_ : NAN;
+  this->period_answers_ = 0;
+  this->period_answer_time_ms_ = 0;
+  return result;
+}
+
+}  // namespace haier
+}  // namespace esphome
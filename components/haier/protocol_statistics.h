@@ -0,0 +1,77 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+// HaierProtocol
+#include <protocol/haier_protocol.h>
+
+namespace esphome {
+namespace haier {
+
+// Request/answer statistics of the Haier protocol collected per frame type.
+// Request is registered when it is queued, every frame written to UART with the same type
+// is counted as an attempt, answer time is measured from the last attempt.
+class ProtocolStatistics {
+ public:
+  static constexpr size_t MAX_FRAME_TYPES = 8;
+  static constexpr size_t HISTOGRAM_BUCKETS = 6;
+  struct FrameStatistics {
+    haier_protocol::FrameType frame_type;
+    uint32_t requests;
+    uint32_t answers;
+    uint32_t timeouts;
+    uint32_t retries;
+    uint32_t min_answer_time_ms;
+    uint32_t max_answer_time_ms;
+    uint32_t total_answer_time_ms;
+    uint32_t histogram[HISTOGRAM_BUCKETS];
+  };
+  // Upper bound of answer time histogram bucket in ms, the last bucket is unbounded (returns 0)
+  static uint32_t get_histogram_limit(size_t bucket);
+  void request_queued(haier_protocol::FrameType type, std::chrono::steady_clock::time_point now);
+  void frame_written(const uint8_t *data, size_t size, std::chrono::steady_clock::time_point now);
+  void answer_received(haier_protocol::FrameType request_type, std::chrono::steady_clock::time_point now);
+  void answer_timeout(haier_protocol::FrameType request_type);
+  size_t get_frame_types_count() const { return this->frame_types_count_; };
+  const FrameStatistics &get_frame_statistics(size_t index) const { return this->frames_[index]; };
+  uint32_t get_total_timeouts() const { return this->total_timeouts_; };
+  uint32_t get_total_retries() const { return this->total_retries_; };
+  // Average answer time since the last call, NAN if there were no answers
+  float pop_period_average_answer_time();
+  // UART reads made by the protocol handler
+  void data_read(size_t size) {
+    this->read_calls_++;
+    this->bytes_read_ += size;
+  };
+  uint32_t get_read_calls() const { return this->read_calls_; };
+  uint32_t get_bytes_read() const { return this->bytes_read_; };
+  // CPU time spent on parsing of status message
+  void status_processed(uint32_t time_us);
+  uint32_t get_status_processed_count() const { return this->status_processed_count_; };
+  uint32_t get_average_status_processing_time() const {
+    return this->status_processed_count_ > 0 ? this->total_status_processing_us_ / this->status_processed_count_ : 0;
+  };
+  uint32_t get_max_status_processing_time() const { return this->max_status_processing_us_; };
+
+ protected:
+  FrameStatistics *get_frame_(haier_protocol::FrameType type);
+  FrameStatistics frames_[MAX_FRAME_TYPES];
+  size_t frame_types_count_{0};
+  bool waiting_answer_{false};
+  haier_protocol::FrameType pending_type_{haier_protocol::FrameType::UNKNOWN_FRAME_TYPE};
+  uint8_t pending_attempts_{0};
+  std::chrono::steady_clock::time_point last_attempt_;
+  uint32_t total_timeouts_{0};
+  uint32_t total_retries_{0};
+  uint32_t period_answers_{0};
+  uint32_t period_answer_time_ms_{0};
+  uint32_t read_calls_{0};
+  uint32_t bytes_read_{0};
+  uint32_t status_processed_count_{0};
+  uint64_t total_status_processing_us_{0};
+  uint32_t max_status_processing_us_{0};
+};
+
+}  // namespace haier
+}  // namespace esphome
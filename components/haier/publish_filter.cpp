@@ -0,0 +1,38 @@
+#include "publish_filter.h"
+
+namespace esphome {
+namespace haier {
+
+void PublishFilter::set_parameters(float deadband, uint32_t min_interval_ms, uint32_t heartbeat_ms) {
+  this->deadband_ = deadband;
+  this->min_interval_ms_ = min_interval_ms;
+  this->heartbeat_ms_ = heartbeat_ms;
+}
+
+bool PublishFilter::should_publish(float value, std::chrono::steady_clock::time_point now) {
+  if (!this->has_published_)
+    return true;
+  bool changed;
+  if (std::isnan(value) || std::isnan(this->last_value_)) {
+    changed = std::isnan(value) != std::isnan(this->last_value_);
+  } else {
+    changed = std::fabs(value - this->last_value_) > this->deadband_;
+  }
+  uint32_t elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - this->last_publish_).count();
+  if (changed && (elapsed >= this->min_interval_ms_))
+    return true;
+  if ((this->heartbeat_ms_ != 0) && (elapsed >= this->heartbeat_ms_))
+    return true;
+  if (!(std::isnan(value) && std::isnan(this->last_value_)) && (value != this->last_value_))
+    this->suppressed_count_++;
+  return false;
+}
+
+void PublishFilter::published(float value, std::chrono::steady_clock::time_point now) {
+  this->has_published_ = true;
+  this->last_value_ = value;
+  this->last_publish_ = now;
+}
+
+}  // namespace haier
+}  // namespace esphome
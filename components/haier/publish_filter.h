@@ -0,0 +1,37 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+namespace esphome {
+namespace haier {
+
+// Decides if a new value of a numeric state should be published.
+// Value is published if it differs from the last published one by more than deadband and
+// min_interval passed since the last publish, or if heartbeat interval passed (0 disables heartbeat).
+// Default filter publishes every change.
+class PublishFilter {
+ public:
+  void set_parameters(float deadband, uint32_t min_interval_ms, uint32_t heartbeat_ms);
+  bool should_publish(float value, std::chrono::steady_clock::time_point now);
+  // Should be called every time the value is published (also when it was published for another reason)
+  void published(float value, std::chrono::steady_clock::time_point now);
+  void reset() { this->has_published_ = false; };
+  bool is_default() const {
+    return (this->deadband_ == 0.0f) && (this->min_interval_ms_ == 0) && (this->heartbeat_ms_ == 0);
+  };
+  uint32_t get_suppressed_count() const { return this->suppressed_count_; };
+
+ protected:
+  float deadband_{0.0f};
+  uint32_t min_interval_ms_{0};
+  uint32_t heartbeat_ms_{0};
+  bool has_published_{false};
+  float last_value_{NAN};
+  std::chrono::steady_clock::time_point last_publish_;
+  uint32_t suppressed_count_{0};  // Changed values that were not published
+};
+
+}  // namespace haier
+}  // namespace esphome
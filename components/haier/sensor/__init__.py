@@ -1,11 +1,14 @@
 import esphome.codegen as cg
-from esphome.components import sensor
+from esphome.components import sensor, time
 import esphome.config_validation as cv
 from esphome.const import (
+    CONF_ENERGY,
     CONF_HUMIDITY,
     CONF_OUTDOOR_TEMPERATURE,
     CONF_POWER,
+    CONF_TIME_ID,
     DEVICE_CLASS_CURRENT,
+    DEVICE_CLASS_ENERGY,
     DEVICE_CLASS_FREQUENCY,
     DEVICE_CLASS_HUMIDITY,
     DEVICE_CLASS_POWER,
@@ -17,25 +20,47 @@ from esphome.const import (
     ICON_HEATING_COIL,
     ICON_PULSE,
     ICON_THERMOMETER,
+    ICON_TIMER,
     ICON_WATER_PERCENT,
     ICON_WEATHER_WINDY,
     STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
     UNIT_AMPERE,
     UNIT_CELSIUS,
     UNIT_HERTZ,
+    UNIT_KILOWATT_HOURS,
+    UNIT_MILLISECOND,
     UNIT_PERCENT,
     UNIT_WATT,
 )
+import esphome.final_validate as fv
 
-from ..climate import CONF_HAIER_ID, HonClimate
+from ..climate import (
+    CONF_HAIER_ID,
+    CONF_PROTOCOL,
+    PROTOCOL_HON,
+    PUBLISH_FILTER_SCHEMA,
+    HaierClimateBase,
+    HonClimate,
+    publish_filter_args,
+)
 
 CODEOWNERS = ["@paveldn"]
 SensorTypeEnum = HonClimate.enum("SubSensorType", True)
+ProtocolSensorTypeEnum = HaierClimateBase.enum("ProtocolSensorType", True)
+
+CONF_PUBLISH_FILTER = "publish_filter"
 
 # Haier sensors
+CONF_ANSWER_TIME = "answer_time"
+CONF_ANSWER_TIMEOUTS = "answer_timeouts"
+CONF_COALESCED_CONTROL_UPDATES = "coalesced_control_updates"
 CONF_COMPRESSOR_CURRENT = "compressor_current"
 CONF_COMPRESSOR_FREQUENCY = "compressor_frequency"
+CONF_DAILY_ENERGY = "daily_energy"
+CONF_DROPPED_CONTROL_UPDATES = "dropped_control_updates"
 CONF_EXPANSION_VALVE_OPEN_DEGREE = "expansion_valve_open_degree"
+CONF_MESSAGE_RETRIES = "message_retries"
 CONF_INDOOR_COIL_TEMPERATURE = "indoor_coil_temperature"
 CONF_OUTDOOR_COIL_TEMPERATURE = "outdoor_coil_temperature"
 CONF_OUTDOOR_DEFROST_TEMPERATURE = "outdoor_defrost_temperature"
@@ -43,7 +68,11 @@ CONF_OUTDOOR_IN_AIR_TEMPERATURE = "outdoor_in_air_temperature"
 CONF_OUTDOOR_OUT_AIR_TEMPERATURE = "outdoor_out_air_temperature"
 
 # Additional icons
+ICON_CALL_MERGE = "mdi:call-merge"
+ICON_FILTER_REMOVE = "mdi:filter-remove-outline"
+ICON_REPEAT = "mdi:repeat"
 ICON_SNOWFLAKE_THERMOMETER = "mdi:snowflake-thermometer"
+ICON_TIMER_OFF = "mdi:timer-off-outline"
 
 SENSOR_TYPES = {
     CONF_COMPRESSOR_CURRENT: sensor.sensor_schema(
@@ -62,6 +91,20 @@ SENSOR_TYPES = {
         state_class=STATE_CLASS_MEASUREMENT,
         entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
     ),
+    CONF_DAILY_ENERGY: sensor.sensor_schema(
+        unit_of_measurement=UNIT_KILOWATT_HOURS,
+        icon=ICON_FLASH,
+        accuracy_decimals=3,
+        device_class=DEVICE_CLASS_ENERGY,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+    ),
+    CONF_ENERGY: sensor.sensor_schema(
+        unit_of_measurement=UNIT_KILOWATT_HOURS,
+        icon=ICON_FLASH,
+        accuracy_decimals=3,
+        device_class=DEVICE_CLASS_ENERGY,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+    ),
     CONF_EXPANSION_VALVE_OPEN_DEGREE: sensor.sensor_schema(
         unit_of_measurement=UNIT_PERCENT,
         icon=ICON_GAUGE,
@@ -133,18 +176,105 @@ SENSOR_TYPES = {
     ),
 }
 
-CONFIG_SCHEMA = cv.Schema(
-    {
-        cv.GenerateID(CONF_HAIER_ID): cv.use_id(HonClimate),
-    }
-).extend({cv.Optional(type_): schema for type_, schema in SENSOR_TYPES.items()})
+# Protocol diagnostic sensors, supported by both protocols
+PROTOCOL_SENSOR_TYPES = {
+    CONF_ANSWER_TIME: sensor.sensor_schema(
+        unit_of_measurement=UNIT_MILLISECOND,
+        icon=ICON_TIMER,
+        accuracy_decimals=0,
+        state_class=STATE_CLASS_MEASUREMENT,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+    CONF_ANSWER_TIMEOUTS: sensor.sensor_schema(
+        icon=ICON_TIMER_OFF,
+        accuracy_decimals=0,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+    CONF_MESSAGE_RETRIES: sensor.sensor_schema(
+        icon=ICON_REPEAT,
+        accuracy_decimals=0,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+    CONF_COALESCED_CONTROL_UPDATES: sensor.sensor_schema(
+        icon=ICON_CALL_MERGE,
+        accuracy_decimals=0,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+    CONF_DROPPED_CONTROL_UPDATES: sensor.sensor_schema(
+        icon=ICON_FILTER_REMOVE,
+        accuracy_decimals=0,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+}
+
+CONFIG_SCHEMA = (
+    cv.Schema(
+        {
+            cv.GenerateID(CONF_HAIER_ID): cv.use_id(HaierClimateBase),
+            # Time source for daily energy reset at midnight
+            cv.Optional(CONF_TIME_ID): cv.use_id(time.RealTimeClock),
+        }
+    )
+    .extend(
+        {
+            cv.Optional(type_): schema.extend(
+                {cv.Optional(CONF_PUBLISH_FILTER): PUBLISH_FILTER_SCHEMA}
+            )
+            for type_, schema in SENSOR_TYPES.items()
+        }
+    )
+    .extend(
+        {
+            cv.Optional(type_): schema
+            for type_, schema in PROTOCOL_SENSOR_TYPES.items()
+        }
+    )
+)
+
+
+def _final_validate(config):
+    if (CONF_DAILY_ENERGY in config) and (CONF_TIME_ID not in config):
+        raise cv.Invalid(f"{CONF_DAILY_ENERGY} sensor requires {CONF_TIME_ID}")
+    full_config = fv.full_config.get()
+    for sensor_type in SENSOR_TYPES:
+        # Check sensors that are only supported for HonClimate
+        if config.get(sensor_type):
+            climate_path = full_config.get_path_for_id(config[CONF_HAIER_ID])[:-1]
+            climate_conf = full_config.get_config_for_path(climate_path)
+            protocol_type = climate_conf.get(CONF_PROTOCOL)
+            if protocol_type.casefold() != PROTOCOL_HON.casefold():
+                raise cv.Invalid(
+                    f"{sensor_type} sensor is only supported for hon climate"
+                )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
 
 
 async def to_code(config):
     paren = await cg.get_variable(config[CONF_HAIER_ID])
+    if CONF_TIME_ID in config:
+        time_ = await cg.get_variable(config[CONF_TIME_ID])
+        cg.add(paren.set_energy_time(time_))
 
     for type_ in SENSOR_TYPES:
         if conf := config.get(type_):
             sens = await sensor.new_sensor(conf)
             sensor_type = getattr(SensorTypeEnum, type_.upper())
             cg.add(paren.set_sub_sensor(sensor_type, sens))
+            if CONF_PUBLISH_FILTER in conf:
+                cg.add(
+                    paren.set_sub_sensor_publish_filter(
+                        sensor_type, *publish_filter_args(conf[CONF_PUBLISH_FILTER])
+                    )
+                )
+    for type_ in PROTOCOL_SENSOR_TYPES:
+        if conf := config.get(type_):
+            sens = await sensor.new_sensor(conf)
+            sensor_type = getattr(ProtocolSensorTypeEnum, type_.upper())
+            cg.add(paren.set_protocol_sensor(sensor_type, sens))
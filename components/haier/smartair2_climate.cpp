@@ -18,7 +18,8 @@ constexpr uint8_t INIT_REQUESTS_RETRY = 2;
 constexpr std::chrono::milliseconds INIT_REQUESTS_RETRY_INTERVAL = std::chrono::milliseconds(2000);
 
 Smartair2Climate::Smartair2Climate() {
-  last_status_message_ = std::unique_ptr<uint8_t[]>(new uint8_t[sizeof(smartair2_protocol::HaierPacketControl)]);
+  static_assert(sizeof(smartair2_protocol::HaierPacketControl) <= MAX_CONTROL_PACKET_SIZE,
+                "Control packet doesn't fit the last status message buffer");
 }
 
 haier_protocol::HandlerError Smartair2Climate::status_handler_(haier_protocol::FrameType request_type,
@@ -28,7 +29,9 @@ haier_protocol::HandlerError Smartair2Climate::status_handler_(haier_protocol::F
       this->answer_preprocess_(request_type, haier_protocol::FrameType::CONTROL, message_type,
                                haier_protocol::FrameType::STATUS, ProtocolPhases::UNKNOWN);
   if (result == haier_protocol::HandlerError::HANDLER_OK) {
+    uint32_t start_us = micros();
     result = this->process_status_message_(data, data_size);
+    this->protocol_statistics_.status_processed(micros() - start_us);
     if (result != haier_protocol::HandlerError::HANDLER_OK) {
       ESP_LOGW(TAG, "Error %d while parsing Status packet", (int) result);
       this->reset_phase_();
@@ -36,7 +39,8 @@ haier_protocol::HandlerError Smartair2Climate::status_handler_(haier_protocol::F
       this->force_send_control_ = false;
     } else {
       if (data_size >= sizeof(smartair2_protocol::HaierPacketControl) + 2) {
-        memcpy(this->last_status_message_.get(), data + 2, sizeof(smartair2_protocol::HaierPacketControl));
+        memcpy(this->last_status_message_, data + 2, sizeof(smartair2_protocol::HaierPacketControl));
+        this->last_status_message_size_ = sizeof(smartair2_protocol::HaierPacketControl);
         this->status_message_callback_.call((const char *) data, data_size);
       } else {
         ESP_LOGW(TAG, "Status packet too small: %d (should be >= %d)", data_size,
@@ -75,6 +79,7 @@ haier_protocol::HandlerError Smartair2Climate::status_handler_(haier_protocol::F
 haier_protocol::HandlerError Smartair2Climate::get_device_version_answer_handler_(
     haier_protocol::FrameType request_type, haier_protocol::FrameType message_type, const uint8_t *data,
     size_t data_size) {
+  this->last_answer_timestamp_ = std::chrono::steady_clock::now();
   if (request_type != haier_protocol::FrameType::GET_DEVICE_VERSION)
     return haier_protocol::HandlerError::UNSUPPORTED_MESSAGE;
   if (ProtocolPhases::SENDING_INIT_1 != this->protocol_phase_)
@@ -86,6 +91,7 @@ haier_protocol::HandlerError Smartair2Climate::get_device_version_answer_handler
                   "instead of smartAir2");
   }
   this->set_phase(ProtocolPhases::SENDING_INIT_2);
+  this->protocol_statistics_.answer_received(request_type, this->last_answer_timestamp_);
   return haier_protocol::HandlerError::HANDLER_OK;
 }
 
@@ -95,6 +101,9 @@ haier_protocol::HandlerError Smartair2Climate::messages_timeout_handler_with_cyc
     return HaierClimateBase::timeout_default_handler_(message_type);
   ESP_LOGI(TAG, "Answer timeout for command %02X, phase %s", (uint8_t) message_type,
            phase_to_string_(this->protocol_phase_));
+  this->protocol_statistics_.answer_timeout(message_type);
+  this->last_answer_timestamp_ = std::chrono::steady_clock::now();
+  this->cancel_fast_start_();
   ProtocolPhases new_phase = (ProtocolPhases) ((int) this->protocol_phase_ + 1);
   if (new_phase >= ProtocolPhases::SENDING_FIRST_ALARM_STATUS_REQUEST)
     new_phase = ProtocolPhases::SENDING_INIT_1;
@@ -156,7 +165,7 @@ void Smartair2Climate::process_phase(std::chrono::steady_clock::time_point now)
         } else {
           this->send_message_(STATUS_REQUEST, this->use_crc_);
         }
-        this->last_status_request_ = now;
+        this->register_status_request_(now);
       }
       break;
 #ifdef USE_WIFI
@@ -178,6 +187,7 @@ void Smartair2Climate::process_phase(std::chrono::steady_clock::time_point now)
       this->set_phase(ProtocolPhases::SENDING_INIT_1);
       break;
     case ProtocolPhases::SENDING_ALARM_STATUS_REQUEST:
+    case ProtocolPhases::SENDING_DEVICE_VERSION_CHECK:
       this->set_phase(ProtocolPhases::IDLE);
       break;
     case ProtocolPhases::SENDING_CONTROL:
@@ -203,7 +213,7 @@ void Smartair2Climate::process_phase(std::chrono::steady_clock::time_point now)
       }
       break;
     case ProtocolPhases::IDLE: {
-      if (this->forced_request_status_ || this->is_status_request_interval_exceeded_(now)) {
+      if (this->should_request_status_(now)) {
         this->set_phase(ProtocolPhases::SENDING_STATUS_REQUEST);
         this->forced_request_status_ = false;
       }
@@ -234,41 +244,42 @@ haier_protocol::HaierMessage Smartair2Climate::get_power_message(bool state) {
 }
 
 haier_protocol::HaierMessage Smartair2Climate::get_control_message() {
+  namespace fields = smartair2_protocol::control_fields;
   uint8_t control_out_buffer[sizeof(smartair2_protocol::HaierPacketControl)];
-  memcpy(control_out_buffer, this->last_status_message_.get(), sizeof(smartair2_protocol::HaierPacketControl));
-  smartair2_protocol::HaierPacketControl *out_data = (smartair2_protocol::HaierPacketControl *) control_out_buffer;
-  out_data->cntrl = 0;
+  memcpy(control_out_buffer, this->last_status_message_, sizeof(smartair2_protocol::HaierPacketControl));
+  fields::CNTRL.set(control_out_buffer, 0);
   if (this->current_hvac_settings_.valid) {
     HvacSettings &climate_control = this->current_hvac_settings_;
     if (climate_control.mode.has_value()) {
       switch (climate_control.mode.value()) {
         case CLIMATE_MODE_OFF:
-          out_data->ac_power = 0;
+          fields::AC_POWER.set(control_out_buffer, 0);
           break;
         case CLIMATE_MODE_HEAT_COOL:
-          out_data->ac_power = 1;
-          out_data->ac_mode = (uint8_t) smartair2_protocol::ConditioningMode::AUTO;
-          out_data->fan_mode = this->other_modes_fan_speed_;
+          fields::AC_POWER.set(control_out_buffer, 1);
+          fields::AC_MODE.set(control_out_buffer, (uint8_t) smartair2_protocol::ConditioningMode::AUTO);
+          fields::FAN_MODE.set(control_out_buffer, this->other_modes_fan_speed_);
           break;
         case CLIMATE_MODE_HEAT:
-          out_data->ac_power = 1;
-          out_data->ac_mode = (uint8_t) smartair2_protocol::ConditioningMode::HEAT;
-          out_data->fan_mode = this->other_modes_fan_speed_;
+          fields::AC_POWER.set(control_out_buffer, 1);
+          fields::AC_MODE.set(control_out_buffer, (uint8_t) smartair2_protocol::ConditioningMode::HEAT);
+          fields::FAN_MODE.set(control_out_buffer, this->other_modes_fan_speed_);
           break;
         case CLIMATE_MODE_DRY:
-          out_data->ac_power = 1;
-          out_data->ac_mode = (uint8_t) smartair2_protocol::ConditioningMode::DRY;
-          out_data->fan_mode = this->other_modes_fan_speed_;
+          fields::AC_POWER.set(control_out_buffer, 1);
+          fields::AC_MODE.set(control_out_buffer, (uint8_t) smartair2_protocol::ConditioningMode::DRY);
+          fields::FAN_MODE.set(control_out_buffer, this->other_modes_fan_speed_);
           break;
         case CLIMATE_MODE_FAN_ONLY:
-          out_data->ac_power = 1;
-          out_data->ac_mode = (uint8_t) smartair2_protocol::ConditioningMode::FAN;
-          out_data->fan_mode = this->fan_mode_speed_;  // Auto doesn't work in fan only mode
+          fields::AC_POWER.set(control_out_buffer, 1);
+          fields::AC_MODE.set(control_out_buffer, (uint8_t) smartair2_protocol::ConditioningMode::FAN);
+          // Auto doesn't work in fan only mode
+          fields::FAN_MODE.set(control_out_buffer, this->fan_mode_speed_);
           break;
         case CLIMATE_MODE_COOL:
-          out_data->ac_power = 1;
-          out_data->ac_mode = (uint8_t) smartair2_protocol::ConditioningMode::COOL;
-          out_data->fan_mode = this->other_modes_fan_speed_;
+          fields::AC_POWER.set(control_out_buffer, 1);
+          fields::AC_MODE.set(control_out_buffer, (uint8_t) smartair2_protocol::ConditioningMode::COOL);
+          fields::FAN_MODE.set(control_out_buffer, this->other_modes_fan_speed_);
           break;
         default:
           ESP_LOGE("Control", "Unsupported climate mode");
@@ -279,17 +290,17 @@ haier_protocol::HaierMessage Smartair2Climate::get_control_message() {
     if (climate_control.fan_mode.has_value()) {
       switch (climate_control.fan_mode.value()) {
         case CLIMATE_FAN_LOW:
-          out_data->fan_mode = (uint8_t) smartair2_protocol::FanMode::FAN_LOW;
+          fields::FAN_MODE.set(control_out_buffer, (uint8_t) smartair2_protocol::FanMode::FAN_LOW);
           break;
         case CLIMATE_FAN_MEDIUM:
-          out_data->fan_mode = (uint8_t) smartair2_protocol::FanMode::FAN_MID;
+          fields::FAN_MODE.set(control_out_buffer, (uint8_t) smartair2_protocol::FanMode::FAN_MID);
           break;
         case CLIMATE_FAN_HIGH:
-          out_data->fan_mode = (uint8_t) smartair2_protocol::FanMode::FAN_HIGH;
+          fields::FAN_MODE.set(control_out_buffer, (uint8_t) smartair2_protocol::FanMode::FAN_HIGH);
           break;
         case CLIMATE_FAN_AUTO:
           if (this->mode != CLIMATE_MODE_FAN_ONLY)  // if we are not in fan only mode
-            out_data->fan_mode = (uint8_t) smartair2_protocol::FanMode::FAN_AUTO;
+            fields::FAN_MODE.set(control_out_buffer, (uint8_t) smartair2_protocol::FanMode::FAN_AUTO);
           break;
         default:
           ESP_LOGE("Control", "Unsupported fan mode");
@@ -301,87 +312,88 @@ haier_protocol::HaierMessage Smartair2Climate::get_control_message() {
       if (this->use_alternative_swing_control_) {
         switch (climate_control.swing_mode.value()) {
           case CLIMATE_SWING_OFF:
-            out_data->swing_mode = 0;
+            fields::SWING_MODE.set(control_out_buffer, 0);
             break;
           case CLIMATE_SWING_VERTICAL:
-            out_data->swing_mode = 1;
+            fields::SWING_MODE.set(control_out_buffer, 1);
             break;
           case CLIMATE_SWING_HORIZONTAL:
-            out_data->swing_mode = 2;
+            fields::SWING_MODE.set(control_out_buffer, 2);
             break;
           case CLIMATE_SWING_BOTH:
-            out_data->swing_mode = 3;
+            fields::SWING_MODE.set(control_out_buffer, 3);
             break;
         }
       } else {
         switch (climate_control.swing_mode.value()) {
           case CLIMATE_SWING_OFF:
-            out_data->use_swing_bits = 0;
-            out_data->swing_mode = 0;
+            fields::USE_SWING_BITS.set(control_out_buffer, 0);
+            fields::SWING_MODE.set(control_out_buffer, 0);
             break;
           case CLIMATE_SWING_VERTICAL:
-            out_data->swing_mode = 0;
-            out_data->vertical_swing = 1;
-            out_data->horizontal_swing = 0;
+            fields::SWING_MODE.set(control_out_buffer, 0);
+            fields::VERTICAL_SWING.set(control_out_buffer, 1);
+            fields::HORIZONTAL_SWING.set(control_out_buffer, 0);
             break;
           case CLIMATE_SWING_HORIZONTAL:
-            out_data->swing_mode = 0;
-            out_data->vertical_swing = 0;
-            out_data->horizontal_swing = 1;
+            fields::SWING_MODE.set(control_out_buffer, 0);
+            fields::VERTICAL_SWING.set(control_out_buffer, 0);
+            fields::HORIZONTAL_SWING.set(control_out_buffer, 1);
             break;
           case CLIMATE_SWING_BOTH:
-            out_data->swing_mode = 1;
-            out_data->use_swing_bits = 0;
-            out_data->vertical_swing = 0;
-            out_data->horizontal_swing = 0;
+            fields::SWING_MODE.set(control_out_buffer, 1);
+            fields::USE_SWING_BITS.set(control_out_buffer, 0);
+            fields::VERTICAL_SWING.set(control_out_buffer, 0);
+            fields::HORIZONTAL_SWING.set(control_out_buffer, 0);
             break;
         }
       }
     }
     if (climate_control.target_temperature.has_value()) {
       float target_temp = climate_control.target_temperature.value();
-      out_data->set_point = ((int) target_temp) - 16;  // set the temperature with offset 16
-      out_data->half_degree = (target_temp - ((int) target_temp) >= 0.49) ? 1 : 0;
+      // set the temperature with offset 16
+      fields::SET_POINT.set(control_out_buffer, ((int) target_temp) - 16);
+      fields::HALF_DEGREE.set(control_out_buffer, (target_temp - ((int) target_temp) >= 0.49) ? 1 : 0);
     }
-    if (out_data->ac_power == 0) {
+    if (fields::AC_POWER.get(control_out_buffer) == 0) {
       // If AC is off - no presets allowed
-      out_data->turbo_mode = 0;
-      out_data->quiet_mode = 0;
+      fields::TURBO_MODE.set(control_out_buffer, 0);
+      fields::QUIET_MODE.set(control_out_buffer, 0);
     } else if (climate_control.preset.has_value()) {
       switch (climate_control.preset.value()) {
         case CLIMATE_PRESET_NONE:
-          out_data->ten_degree = 0;
-          out_data->turbo_mode = 0;
-          out_data->quiet_mode = 0;
+          fields::TEN_DEGREE.set(control_out_buffer, 0);
+          fields::TURBO_MODE.set(control_out_buffer, 0);
+          fields::QUIET_MODE.set(control_out_buffer, 0);
           break;
         case CLIMATE_PRESET_BOOST:
-          out_data->ten_degree = 0;
-          out_data->turbo_mode = 1;
-          out_data->quiet_mode = 0;
+          fields::TEN_DEGREE.set(control_out_buffer, 0);
+          fields::TURBO_MODE.set(control_out_buffer, 1);
+          fields::QUIET_MODE.set(control_out_buffer, 0);
           break;
         case CLIMATE_PRESET_COMFORT:
-          out_data->ten_degree = 0;
-          out_data->turbo_mode = 0;
-          out_data->quiet_mode = 1;
+          fields::TEN_DEGREE.set(control_out_buffer, 0);
+          fields::TURBO_MODE.set(control_out_buffer, 0);
+          fields::QUIET_MODE.set(control_out_buffer, 1);
           break;
         case CLIMATE_PRESET_AWAY:
           // Only allowed in heat mode
-          out_data->ten_degree = (this->mode == CLIMATE_MODE_HEAT) ? 1 : 0;
-          out_data->turbo_mode = 0;
-          out_data->quiet_mode = 0;
+          fields::TEN_DEGREE.set(control_out_buffer, (this->mode == CLIMATE_MODE_HEAT) ? 1 : 0);
+          fields::TURBO_MODE.set(control_out_buffer, 0);
+          fields::QUIET_MODE.set(control_out_buffer, 0);
           break;
         default:
           ESP_LOGE("Control", "Unsupported preset");
-          out_data->ten_degree = 0;
-          out_data->turbo_mode = 0;
-          out_data->quiet_mode = 0;
+          fields::TEN_DEGREE.set(control_out_buffer, 0);
+          fields::TURBO_MODE.set(control_out_buffer, 0);
+          fields::QUIET_MODE.set(control_out_buffer, 0);
           break;
       }
     }
   }
-  out_data->display_status = this->get_display_state() ? 0 : 1;
+  fields::DISPLAY_STATUS.set(control_out_buffer, this->get_display_state() ? 0 : 1);
   this->display_status_ = (SwitchState) ((uint8_t) this->display_status_ & 0b01);
-  out_data->health_mode = this->get_health_mode() ? 1 : 0;
+  fields::HEALTH_MODE.set(control_out_buffer, this->get_health_mode() ? 1 : 0);
   this->health_mode_ = (SwitchState) ((uint8_t) this->health_mode_ & 0b01);
   return haier_protocol::HaierMessage(haier_protocol::FrameType::CONTROL, 0x4D5F, control_out_buffer,
                                       sizeof(smartair2_protocol::HaierPacketControl));
@@ -390,17 +402,16 @@ haier_protocol::HaierMessage Smartair2Climate::get_control_message() {
 haier_protocol::HandlerError Smartair2Climate::process_status_message_(const uint8_t *packet_buffer, uint8_t size) {
   if (size != sizeof(smartair2_protocol::HaierStatus))
     return haier_protocol::HandlerError::WRONG_MESSAGE_STRUCTURE;
-  smartair2_protocol::HaierStatus packet;
-  memcpy(&packet, packet_buffer, size);
+  smartair2_protocol::HaierPacketControlView control(packet_buffer + 2, size - 2);
   bool should_publish = false;
   {
     // Extra modes/presets
     optional<ClimatePreset> old_preset = this->preset;
-    if (packet.control.turbo_mode != 0) {
+    if (control.turbo_mode()) {
       this->preset = CLIMATE_PRESET_BOOST;
-    } else if (packet.control.quiet_mode != 0) {
+    } else if (control.quiet_mode()) {
       this->preset = CLIMATE_PRESET_COMFORT;
-    } else if (packet.control.ten_degree != 0) {
+    } else if (control.ten_degree()) {
       this->preset = CLIMATE_PRESET_AWAY;
     } else {
       this->preset = CLIMATE_PRESET_NONE;
@@ -411,30 +422,30 @@ haier_protocol::HandlerError Smartair2Climate::process_status_message_(const uin
   {
     // Target temperature
     float old_target_temperature = this->target_temperature;
-    this->target_temperature = packet.control.set_point + 16.0f + ((packet.control.half_degree == 1) ? 0.5f : 0.0f);
+    this->target_temperature = control.set_point() + 16.0f + (control.half_degree() ? 0.5f : 0.0f);
     should_publish = should_publish || (old_target_temperature != this->target_temperature);
   }
   {
     // Current temperature
-    float old_current_temperature = this->current_temperature;
-    this->current_temperature = packet.control.room_temperature;
-    should_publish = should_publish || (old_current_temperature != this->current_temperature);
+    this->current_temperature = control.room_temperature();
+    should_publish = should_publish || this->current_temperature_filter_.should_publish(
+                                           this->current_temperature, std::chrono::steady_clock::now());
   }
   {
     // Fan mode
     optional<ClimateFanMode> old_fan_mode = this->fan_mode;
     // remember the fan speed we last had for climate vs fan
-    if (packet.control.ac_mode == (uint8_t) smartair2_protocol::ConditioningMode::FAN) {
-      if (packet.control.fan_mode != (uint8_t) smartair2_protocol::FanMode::FAN_AUTO)
-        this->fan_mode_speed_ = packet.control.fan_mode;
+    if (control.ac_mode() == (uint8_t) smartair2_protocol::ConditioningMode::FAN) {
+      if (control.fan_mode() != (uint8_t) smartair2_protocol::FanMode::FAN_AUTO)
+        this->fan_mode_speed_ = control.fan_mode();
     } else {
-      this->other_modes_fan_speed_ = packet.control.fan_mode;
+      this->other_modes_fan_speed_ = control.fan_mode();
     }
-    switch (packet.control.fan_mode) {
+    switch (control.fan_mode()) {
       case (uint8_t) smartair2_protocol::FanMode::FAN_AUTO:
         // Sometimes AC reports in fan only mode that fan speed is auto
         // but never accept this value back
-        if (packet.control.ac_mode != (uint8_t) smartair2_protocol::ConditioningMode::FAN) {
+        if (control.ac_mode() != (uint8_t) smartair2_protocol::ConditioningMode::FAN) {
           this->fan_mode = CLIMATE_FAN_AUTO;
         } else {
           should_publish = true;
@@ -455,9 +466,9 @@ haier_protocol::HandlerError Smartair2Climate::process_status_message_(const uin
   }
   // Display status
   // should be before "Climate mode" because it is changing this->mode
-  if (packet.control.ac_power != 0) {
+  if (control.ac_power()) {
     // if AC is off display status always ON so process it only when AC is on
-    bool disp_status = packet.control.display_status == 0;
+    bool disp_status = !control.display_status();
     if (disp_status != this->get_display_state()) {
       // Do something only if display status changed
       if (this->mode == CLIMATE_MODE_OFF) {
@@ -471,17 +482,17 @@ haier_protocol::HandlerError Smartair2Climate::process_status_message_(const uin
   // Health mode
   if ((((uint8_t) this->health_mode_) & 0b10) == 0) {
     bool old_health_mode = this->get_health_mode();
-    this->health_mode_ = packet.control.health_mode == 1 ? SwitchState::ON : SwitchState::OFF;
+    this->health_mode_ = control.health_mode() ? SwitchState::ON : SwitchState::OFF;
     should_publish = should_publish || (old_health_mode != this->get_health_mode());
   }
   {
     // Climate mode
     ClimateMode old_mode = this->mode;
-    if (packet.control.ac_power == 0) {
+    if (!control.ac_power()) {
       this->mode = CLIMATE_MODE_OFF;
     } else {
       // Check current hvac mode
-      switch (packet.control.ac_mode) {
+      switch (control.ac_mode()) {
         case (uint8_t) smartair2_protocol::ConditioningMode::COOL:
           this->mode = CLIMATE_MODE_COOL;
           break;
@@ -505,7 +516,7 @@ haier_protocol::HandlerError Smartair2Climate::process_status_message_(const uin
     // Swing mode
     ClimateSwingMode old_swing_mode = this->swing_mode;
     if (this->use_alternative_swing_control_) {
-      switch (packet.control.swing_mode) {
+      switch (control.swing_mode()) {
         case 1:
           this->swing_mode = CLIMATE_SWING_VERTICAL;
           break;
@@ -520,10 +531,10 @@ haier_protocol::HandlerError Smartair2Climate::process_status_message_(const uin
           break;
       }
     } else {
-      if (packet.control.swing_mode == 0) {
-        if (packet.control.vertical_swing != 0) {
+      if (control.swing_mode() == 0) {
+        if (control.vertical_swing()) {
           this->swing_mode = CLIMATE_SWING_VERTICAL;
-        } else if (packet.control.horizontal_swing != 0) {
+        } else if (control.horizontal_swing()) {
           this->swing_mode = CLIMATE_SWING_HORIZONTAL;
         } else {
           this->swing_mode = CLIMATE_SWING_OFF;
@@ -536,17 +547,19 @@ haier_protocol::HandlerError Smartair2Climate::process_status_message_(const uin
   }
   this->last_valid_status_timestamp_ = std::chrono::steady_clock::now();
   if (should_publish) {
+    this->last_state_change_timestamp_ = this->last_valid_status_timestamp_;
     this->publish_state();
+    this->current_temperature_filter_.published(this->current_temperature, this->last_valid_status_timestamp_);
   }
   if (should_publish) {
     ESP_LOGI(TAG, "HVAC values changed");
   }
   int log_level = should_publish ? ESPHOME_LOG_LEVEL_INFO : ESPHOME_LOG_LEVEL_DEBUG;
-  esp_log_printf_(log_level, TAG, __LINE__, "HVAC Mode = 0x%X", packet.control.ac_mode);
-  esp_log_printf_(log_level, TAG, __LINE__, "Fan speed Status = 0x%X", packet.control.fan_mode);
-  esp_log_printf_(log_level, TAG, __LINE__, "Horizontal Swing Status = 0x%X", packet.control.horizontal_swing);
-  esp_log_printf_(log_level, TAG, __LINE__, "Vertical Swing Status = 0x%X", packet.control.vertical_swing);
-  esp_log_printf_(log_level, TAG, __LINE__, "Set Point Status = 0x%X", packet.control.set_point);
+  esp_log_printf_(log_level, TAG, __LINE__, "HVAC Mode = 0x%X", control.ac_mode());
+  esp_log_printf_(log_level, TAG, __LINE__, "Fan speed Status = 0x%X", control.fan_mode());
+  esp_log_printf_(log_level, TAG, __LINE__, "Horizontal Swing Status = 0x%X", control.horizontal_swing());
+  esp_log_printf_(log_level, TAG, __LINE__, "Vertical Swing Status = 0x%X", control.vertical_swing());
+  esp_log_printf_(log_level, TAG, __LINE__, "Set Point Status = 0x%X", control.set_point());
   return haier_protocol::HandlerError::HANDLER_OK;
 }
 
@@ -1,5 +1,8 @@
 ﻿#pragma once
 
+#include <cstdint>
+#include "packet_view.h"
+
 namespace esphome {
 namespace haier {
 namespace smartair2_protocol {
@@ -83,6 +86,57 @@ struct HaierStatus {
   HaierPacketControl control;
 };
 
+static_assert(sizeof(HaierPacketControl) == 24, "Unexpected HaierPacketControl size");
+
+// Field descriptors of HaierPacketControl, offsets are relative to the beginning of the packet.
+// Structure defines the packet size, descriptors are used to decode and encode fields.
+namespace control_fields {
+constexpr PacketField ROOM_TEMPERATURE{1, 0, 8};
+constexpr PacketField ROOM_HUMIDITY{3, 0, 8};
+constexpr PacketField CNTRL{5, 0, 8};
+constexpr PacketField AC_MODE{11, 0, 8};
+constexpr PacketField FAN_MODE{13, 0, 8};
+constexpr PacketField SWING_MODE{15, 0, 8};
+constexpr PacketField USE_FAHRENHEIT{16, 3, 1};
+constexpr PacketField LOCK_REMOTE{16, 7, 1};
+constexpr PacketField AC_POWER{17, 0, 1};
+constexpr PacketField HEALTH_MODE{17, 3, 1};
+constexpr PacketField COMPRESSOR{17, 4, 1};
+constexpr PacketField HALF_DEGREE{17, 5, 1};
+constexpr PacketField TEN_DEGREE{17, 6, 1};
+constexpr PacketField USE_SWING_BITS{19, 0, 1};
+constexpr PacketField TURBO_MODE{19, 1, 1};
+constexpr PacketField QUIET_MODE{19, 2, 1};
+constexpr PacketField HORIZONTAL_SWING{19, 3, 1};
+constexpr PacketField VERTICAL_SWING{19, 4, 1};
+constexpr PacketField DISPLAY_STATUS{19, 5, 1};
+constexpr PacketField SET_POINT{23, 0, 8};
+}  // namespace control_fields
+
+// Zero-copy view of HaierPacketControl
+class HaierPacketControlView : public PacketView {
+ public:
+  using PacketView::PacketView;
+  explicit HaierPacketControlView(const PacketView &view) : PacketView(view) {}
+  uint8_t room_temperature() const { return this->get(control_fields::ROOM_TEMPERATURE); };
+  uint8_t room_humidity() const { return this->get(control_fields::ROOM_HUMIDITY); };
+  uint8_t ac_mode() const { return this->get(control_fields::AC_MODE); };
+  uint8_t fan_mode() const { return this->get(control_fields::FAN_MODE); };
+  uint8_t swing_mode() const { return this->get(control_fields::SWING_MODE); };
+  bool use_fahrenheit() const { return this->get(control_fields::USE_FAHRENHEIT) != 0; };
+  bool lock_remote() const { return this->get(control_fields::LOCK_REMOTE) != 0; };
+  bool ac_power() const { return this->get(control_fields::AC_POWER) != 0; };
+  bool health_mode() const { return this->get(control_fields::HEALTH_MODE) != 0; };
+  bool half_degree() const { return this->get(control_fields::HALF_DEGREE) != 0; };
+  bool ten_degree() const { return this->get(control_fields::TEN_DEGREE) != 0; };
+  bool turbo_mode() const { return this->get(control_fields::TURBO_MODE) != 0; };
+  bool quiet_mode() const { return this->get(control_fields::QUIET_MODE) != 0; };
+  bool horizontal_swing() const { return this->get(control_fields::HORIZONTAL_SWING) != 0; };
+  bool vertical_swing() const { return this->get(control_fields::VERTICAL_SWING) != 0; };
+  bool display_status() const { return this->get(control_fields::DISPLAY_STATUS) != 0; };
+  uint8_t set_point() const { return this->get(control_fields::SET_POINT); };
+};
+
 }  // namespace smartair2_protocol
 }  // namespace haier
 }  // namespace esphome
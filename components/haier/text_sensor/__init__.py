@@ -1,7 +1,7 @@
 import esphome.codegen as cg
-from esphome.components import text_sensor
+from esphome.components import text_sensor, time
 import esphome.config_validation as cv
-from esphome.const import ENTITY_CATEGORY_DIAGNOSTIC, ENTITY_CATEGORY_NONE
+from esphome.const import CONF_TIME_ID, ENTITY_CATEGORY_DIAGNOSTIC, ENTITY_CATEGORY_NONE
 
 from ..climate import CONF_HAIER_ID, HonClimate
 
@@ -12,10 +12,12 @@ TextSensorTypeEnum = HonClimate.enum("SubTextSensorType", True)
 CONF_CLEANING_STATUS = "cleaning_status"
 CONF_PROTOCOL_VERSION = "protocol_version"
 CONF_APPLIANCE_NAME = "appliance_name"
+CONF_ALARM_HISTORY = "alarm_history"
 
 # Additional icons
 ICON_SPRAY_BOTTLE = "mdi:spray-bottle"
 ICON_TEXT_BOX = "mdi:text-box-outline"
+ICON_ALERT_CIRCLE = "mdi:alert-circle-outline"
 
 TEXT_SENSOR_TYPES = {
     CONF_CLEANING_STATUS: text_sensor.text_sensor_schema(
@@ -30,17 +32,26 @@ TEXT_SENSOR_TYPES = {
         icon=ICON_TEXT_BOX,
         entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
     ),
+    CONF_ALARM_HISTORY: text_sensor.text_sensor_schema(
+        icon=ICON_ALERT_CIRCLE,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
 }
 
 CONFIG_SCHEMA = cv.Schema(
     {
         cv.GenerateID(CONF_HAIER_ID): cv.use_id(HonClimate),
+        # Time source for alarm history timestamps
+        cv.Optional(CONF_TIME_ID): cv.use_id(time.RealTimeClock),
     }
 ).extend({cv.Optional(type): schema for type, schema in TEXT_SENSOR_TYPES.items()})
 
 
 async def to_code(config):
     paren = await cg.get_variable(config[CONF_HAIER_ID])
+    if CONF_TIME_ID in config:
+        time_ = await cg.get_variable(config[CONF_TIME_ID])
+        cg.add(paren.set_alarm_history_time(time_))
 
     for type_ in TEXT_SENSOR_TYPES:
         if conf := config.get(type_):
@@ -0,0 +1,31 @@
+#pragma once
+
+// Counts heap allocations made with operator new in the host build.
+// Included only by host-allocations-*.yaml configurations.
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace haier_benchmark {
+
+inline std::atomic<uint32_t> &allocations_counter() {
+  static std::atomic<uint32_t> counter{0};
+  return counter;
+}
+
+}  // namespace haier_benchmark
+
+void *operator new(std::size_t size) {
+  haier_benchmark::allocations_counter()++;
+  void *ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr)
+    std::abort();
+  return ptr;
+}
+
+void *operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
@@ -0,0 +1,315 @@
+#!/usr/bin/env python3
+"""Replay of a frame capture against the Haier component running on the ESPHome host platform.
+
+The capture is recorded by the component itself (frame_capture_size option,
+climate.haier.dump_frame_capture action). It can be a binary capture file or
+the device log with the base64 encoded capture.
+
+Appliance frames of the capture are used as answers: every request sent by the
+host program is answered with the frames that followed the next not yet used
+captured request of the same type. Answers of every request type are replayed
+in the captured order no matter how the component interleaves its requests, so
+the sequence of climate states doesn't depend on the timing of the run. The
+replay ends when all answers to the most frequent request (status polling) are
+used. The script reports:
+
+- how many requests of the component were answered from the capture,
+- climate state changes (logged by host-replay-*.yaml), compared with the
+  golden trace if it is given,
+- replay throughput (answered requests per second) and CPU time spent in
+  process_status_message_ per status message.
+
+Requests sent by the component depend on the timing of the run, they are
+reported but not compared with the golden trace.
+
+Usage:
+
+    esphome compile host-replay-hon.yaml
+    python3 capture_replay.py --protocol hon capture.log --golden capture.golden.json --update-golden
+    python3 capture_replay.py --protocol hon capture.log --golden capture.golden.json
+"""
+
+import argparse
+import base64
+import collections
+import json
+import os
+import pty
+import re
+import select
+import subprocess
+import sys
+import time
+
+import haier_simulator
+from run_benchmark import ANSI_ESCAPE, default_binary, read_cpu_time
+
+CAPTURE_MAGIC = b"HCAP"
+CAPTURE_HEADER_SIZE = 12
+RECORD_HEADER_SIZE = 6
+DIRECTION_RX = 0
+DIRECTION_TX = 1
+
+CAPTURE_LINE_RE = re.compile(r"Frame capture: ([A-Za-z0-9+/=]+)")
+CAPTURE_BEGIN_RE = re.compile(r"Frame capture begin")
+STATE_RE = re.compile(r"\[replay(?::\d+)?\]: (State: .*)")
+STATUS_PROCESSING_RE = re.compile(
+    r"\[replay(?::\d+)?\]: Status processing: (\d+) messages, avg (\d+) us, max (\d+) us"
+)
+
+
+def parse_capture(data):
+    if data[:4] != CAPTURE_MAGIC or len(data) < CAPTURE_HEADER_SIZE:
+        raise ValueError("Not a Haier frame capture")
+    dropped = int.from_bytes(data[8:12], "little")
+    records = []
+    pos = CAPTURE_HEADER_SIZE
+    while pos + RECORD_HEADER_SIZE <= len(data):
+        timestamp = int.from_bytes(data[pos : pos + 4], "little")
+        direction = data[pos + 4]
+        size = data[pos + 5]
+        records.append((timestamp, direction, data[pos + RECORD_HEADER_SIZE : pos + RECORD_HEADER_SIZE + size]))
+        pos += RECORD_HEADER_SIZE + size
+    return records, dropped
+
+
+def load_capture(path):
+    with open(path, "rb") as capture_file:
+        data = capture_file.read()
+    if data[:4] == CAPTURE_MAGIC:
+        return parse_capture(data)
+    # Device log, the last dump is used
+    chunks = []
+    for line in data.decode("utf-8", "replace").splitlines():
+        line = ANSI_ESCAPE.sub("", line)
+        if CAPTURE_BEGIN_RE.search(line):
+            chunks = []
+        match = CAPTURE_LINE_RE.search(line)
+        if match:
+            chunks.append(base64.b64decode(match.group(1)))
+    if not chunks:
+        raise ValueError(f"No frame capture found in {path}")
+    return parse_capture(b"".join(chunks))
+
+
+def frame_key(frame):
+    if frame.frame_type == haier_simulator.FRAME_CONTROL:
+        return frame.frame_type, frame.subcommand
+    return frame.frame_type, None
+
+
+def describe_key(key):
+    frame_type, subcommand = key
+    return f"{frame_type:02X}" if subcommand is None else f"{frame_type:02X}:{subcommand:04X}"
+
+
+class Exchange:
+    def __init__(self, request, timestamp):
+        self.request = request
+        self.timestamp = timestamp
+        self.answers = []
+
+
+def build_exchanges(records):
+    """Splits the capture into requests of the component and frames of the appliance that followed them."""
+    decoders = {DIRECTION_RX: haier_simulator.FrameDecoder(), DIRECTION_TX: haier_simulator.FrameDecoder()}
+    exchanges = []
+    for timestamp, direction, data in records:
+        if direction not in decoders:
+            continue
+        for frame in decoders[direction].feed(data):
+            if direction == DIRECTION_TX:
+                exchanges.append(Exchange(frame, timestamp))
+            elif exchanges:
+                exchanges[-1].answers.append((frame.frame_type, frame.data))
+    return exchanges, decoders[DIRECTION_RX].errors + decoders[DIRECTION_TX].errors
+
+
+class ReplayAppliance:
+    """Appliance model that answers with the captured frames."""
+
+    def __init__(self, protocol, exchanges):
+        self.protocol = protocol
+        self.static = True
+        # Captured exchanges of every request type in the captured order
+        self.queues = collections.defaultdict(collections.deque)
+        for exchange in exchanges:
+            self.queues[frame_key(exchange.request)].append(exchange)
+        self.polling_key = max(self.queues, key=lambda key: len(self.queues[key]))
+        self.replayed = 0
+        self.matched_exactly = 0
+        self.unmatched = 0
+        self.requests = []
+        self.last_answers = {}
+
+    @property
+    def finished(self):
+        return not self.queues[self.polling_key]
+
+    def tick(self, seconds):
+        pass
+
+    def process(self, frame):
+        key = frame_key(frame)
+        self.requests.append(describe_key(key))
+        queue = self.queues.get(key)
+        if queue:
+            exchange = queue.popleft()
+            self.replayed += 1
+            if exchange.request.data == frame.data:
+                self.matched_exactly += 1
+            self.last_answers[key] = exchange.answers
+            return list(exchange.answers) or None
+        # Not in the capture or all answers are used, repeat the last answer to keep the component running
+        self.unmatched += 1
+        if key in self.last_answers:
+            return list(self.last_answers[key]) or None
+        return haier_simulator.FRAME_INVALID, b""
+
+
+def run_replay(args, appliance):
+    config = args.config or f"host-replay-{args.protocol}"
+    binary = args.binary or default_binary(config)
+    if not os.path.isfile(binary):
+        sys.exit(f"Host binary not found: {binary}, compile {config}.yaml first")
+    simulator = haier_simulator.Simulator(appliance, args.port)
+    simulator.start()
+    out_master, out_slave = pty.openpty()
+    start_time = time.monotonic()
+    process = subprocess.Popen([binary], stdout=out_slave, stderr=out_slave, stdin=subprocess.DEVNULL)
+    os.close(out_slave)
+    states = []
+    processing = None
+    cpu_time = 0.0
+    pending = b""
+    # Give the component time to report status processing statistics after the last frame
+    finish_time = None
+    try:
+        while time.monotonic() - start_time < args.timeout:
+            if appliance.finished and finish_time is None:
+                finish_time = time.monotonic()
+            if (finish_time is not None) and (time.monotonic() - finish_time > args.tail):
+                break
+            ready, _, _ = select.select([out_master], [], [], 0.1)
+            if not ready:
+                if process.poll() is not None:
+                    break
+                continue
+            try:
+                chunk = os.read(out_master, 4096)
+            except OSError:
+                break
+            pending += chunk
+            *lines, pending = pending.split(b"\n")
+            for line in lines:
+                line = ANSI_ESCAPE.sub("", line.decode("utf-8", "replace")).rstrip()
+                if args.verbose and line:
+                    print(line, file=sys.stderr)
+                match = STATE_RE.search(line)
+                if match and (not states or states[-1] != match.group(1)):
+                    states.append(match.group(1))
+                match = STATUS_PROCESSING_RE.search(line)
+                if match:
+                    processing = tuple(int(v) for v in match.groups())
+        if process.poll() is None:
+            cpu_time = read_cpu_time(process.pid)
+    finally:
+        end_time = finish_time or time.monotonic()
+        if process.poll() is None:
+            process.terminate()
+            process.wait()
+        os.close(out_master)
+        simulator.stop()
+    return states, processing, end_time - start_time, cpu_time, simulator.decoder.errors
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Replay of Haier frame capture on the ESPHome host platform")
+    parser.add_argument("capture", help="binary capture or device log with dump_frame_capture output")
+    parser.add_argument("--protocol", choices=["hon", "smartair2"], default="hon")
+    parser.add_argument("--config", help="name of the configuration, default: host-replay-<protocol>")
+    parser.add_argument("--binary", help="host program, default: .esphome build of the configuration")
+    parser.add_argument("--port", default="/tmp/haier-simulator", help="must match port in the replay yaml")
+    parser.add_argument("--timeout", type=float, default=300.0, help="maximal replay duration, seconds")
+    parser.add_argument("--tail", type=float, default=6.0, help="seconds to run after the last captured frame")
+    parser.add_argument("--golden", help="golden trace json file to compare states with")
+    parser.add_argument("--update-golden", action="store_true", help="save the result as the golden trace")
+    parser.add_argument("--max-status-processing-us", type=float, help="fail if average status parsing is slower")
+    parser.add_argument("--json", help="save results to json file")
+    parser.add_argument("-v", "--verbose", action="store_true", help="print host program log")
+    args = parser.parse_args()
+
+    records, dropped = load_capture(args.capture)
+    exchanges, capture_errors = build_exchanges(records)
+    if not exchanges:
+        sys.exit("No requests in the capture")
+    appliance = ReplayAppliance(args.protocol, exchanges)
+    states, processing, duration, cpu_time, frame_errors = run_replay(args, appliance)
+
+    result = {
+        "protocol": args.protocol,
+        "captured_requests": len(exchanges),
+        "captured_records_dropped": dropped,
+        "capture_frame_errors": capture_errors,
+        "replayed_requests": appliance.replayed,
+        "requests": len(appliance.requests),
+        "exactly_matched_requests": appliance.matched_exactly,
+        "unmatched_requests": appliance.unmatched,
+        "frame_errors": frame_errors,
+        "duration_s": duration,
+        "requests_per_second": appliance.replayed / max(duration, 1e-6),
+        "cpu_time_s": cpu_time,
+        "states": states,
+        "request_sequence": appliance.requests,
+    }
+    if processing is not None:
+        result["status_messages"], result["status_processing_avg_us"], result["status_processing_max_us"] = processing
+
+    print(f"Protocol:                   {args.protocol}")
+    print(f"Captured requests:          {len(exchanges)} ({dropped} records dropped, {capture_errors} broken frames)")
+    print(f"Replayed requests:          {appliance.replayed} in {duration:.2f} s")
+    print(
+        f"Component requests:         {len(appliance.requests)}, answered from capture {appliance.replayed} "
+        f"(exactly matched {appliance.matched_exactly}), not in capture {appliance.unmatched}"
+    )
+    print(f"Requests per second:        {result['requests_per_second']:.2f}")
+    print(f"Frame errors:               {frame_errors}")
+    if processing is not None:
+        print(f"Status processing:          {processing[0]} messages, avg {processing[1]} us, max {processing[2]} us")
+    print(f"State changes:              {len(states)}")
+
+    failed = []
+    if not appliance.finished:
+        failed.append("Replay didn't reach the end of the capture")
+    if args.golden:
+        if args.update_golden:
+            with open(args.golden, "w", encoding="utf-8") as golden_file:
+                json.dump({"states": states}, golden_file, indent=2)
+                golden_file.write("\n")
+            print(f"Golden trace saved to {args.golden}")
+        else:
+            with open(args.golden, encoding="utf-8") as golden_file:
+                expected = json.load(golden_file).get("states", [])
+            if expected != states:
+                index = next(
+                    (i for i, (e, a) in enumerate(zip(expected, states)) if e != a), min(len(expected), len(states))
+                )
+                failed.append(
+                    f"States differ from golden trace at {index}: expected "
+                    f"{expected[index] if index < len(expected) else '<end>'}, got "
+                    f"{states[index] if index < len(states) else '<end>'}"
+                )
+            result["golden_match"] = expected == states
+    if (args.max_status_processing_us is not None) and (
+        (processing is None) or (processing[1] > args.max_status_processing_us)
+    ):
+        failed.append("Status processing is slower than allowed or wasn't reported")
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as json_file:
+            json.dump(result, json_file, indent=2)
+    if failed:
+        sys.exit("\n".join(failed))
+
+
+if __name__ == "__main__":
+    main()
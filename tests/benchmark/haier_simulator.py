@@ -0,0 +1,477 @@
+#!/usr/bin/env python3
+"""Simulated Haier appliance connected to a pseudo-terminal.
+
+The simulator creates a pty, makes its slave side available through a symlink
+(default /tmp/haier-simulator) and answers the requests sent by the ESPHome
+Haier component. Both hOn and smartAir2 protocol variants are supported.
+
+Can be used standalone:
+
+    python3 haier_simulator.py --protocol hon --port /tmp/haier-simulator
+
+or imported by run_benchmark.py which uses the frame event log to measure
+the component performance.
+"""
+
+import argparse
+import os
+import select
+import sys
+import threading
+import time
+import tty
+
+# Frame types (see HaierProtocol haier_frame_types.h)
+FRAME_CONTROL = 0x01
+FRAME_STATUS = 0x02
+FRAME_INVALID = 0x03
+FRAME_ALARM_STATUS = 0x04
+FRAME_CONFIRM = 0x05
+FRAME_GET_DEVICE_VERSION = 0x61
+FRAME_GET_DEVICE_VERSION_RESPONSE = 0x62
+FRAME_GET_DEVICE_ID = 0x70
+FRAME_GET_DEVICE_ID_RESPONSE = 0x71
+FRAME_GET_ALARM_STATUS = 0x73
+FRAME_GET_ALARM_STATUS_RESPONSE = 0x74
+FRAME_GET_MANAGEMENT_INFORMATION = 0x7C
+FRAME_GET_MANAGEMENT_INFORMATION_RESPONSE = 0x7D
+FRAME_REPORT_NETWORK_STATUS = 0xF7
+
+FRAME_HEADER = b"\xFF\xFF"
+FLAG_CRC = 0x40
+# Length byte, flags, 5 reserved bytes and frame type
+FRAME_HEADER_SIZE = 8
+
+# hOn control subcommands
+HON_GET_USER_DATA = 0x4D01
+HON_GET_BIG_DATA = 0x4DFE
+HON_SET_SINGLE_PARAMETER = 0x5D00
+HON_SET_GROUP_PARAMETERS = 0x6001
+HON_CONTROL_PACKET_SIZE = 10
+HON_SENSORS_PACKET_SIZE = 22
+HON_BIG_DATA_PACKET_SIZE = 14
+HON_ALARMS_SIZE = 8
+
+# smartAir2 control subcommands
+SMARTAIR2_GET_STATUS = 0x4D01
+SMARTAIR2_POWER_ON = 0x4D02
+SMARTAIR2_POWER_OFF = 0x4D03
+SMARTAIR2_SET_CONTROL = 0x4D5F
+SMARTAIR2_CONTROL_PACKET_SIZE = 24
+
+
+def checksum(data):
+    return sum(data) & 0xFF
+
+
+def crc16(data):
+    # CRC-16/ARC
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            if crc & 0x01:
+                crc = (crc >> 1) ^ 0xA001
+            else:
+                crc >>= 1
+    return crc
+
+
+def encode_frame(frame_type, data=b"", use_crc=True, reserved=b"\x00" * 5):
+    body = bytes([FRAME_HEADER_SIZE + len(data), FLAG_CRC if use_crc else 0x00]) + reserved + bytes([frame_type])
+    body += bytes(data)
+    body += bytes([checksum(body)])
+    if use_crc:
+        crc = crc16(body[:-1])
+        body += bytes([crc >> 8, crc & 0xFF])
+    # 0xFF inside the frame is followed by 0x55
+    return FRAME_HEADER + body.replace(b"\xFF", b"\xFF\x55")
+
+
+class Frame:
+    def __init__(self, frame_type, data, use_crc, reserved):
+        self.frame_type = frame_type
+        self.data = data
+        self.use_crc = use_crc
+        self.reserved = reserved
+
+    @property
+    def subcommand(self):
+        if len(self.data) < 2:
+            return None
+        return (self.data[0] << 8) | self.data[1]
+
+    def __str__(self):
+        return f"type {self.frame_type:02X}, data: {self.data.hex(' ').upper()}"
+
+
+class FrameDecoder:
+    """Incremental decoder of the byte stream, returns complete frames."""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.errors = 0
+
+    def feed(self, data):
+        self.buffer += data
+        frames = []
+        while True:
+            start = self.buffer.find(FRAME_HEADER)
+            if start < 0:
+                # Keep last byte, it can be the first half of the header
+                del self.buffer[: max(len(self.buffer) - 1, 0)]
+                return frames
+            del self.buffer[:start]
+            body = bytearray()
+            pos = 2
+            expected = None
+            while pos < len(self.buffer):
+                byte = self.buffer[pos]
+                pos += 1
+                if byte == 0xFF:
+                    if pos >= len(self.buffer):
+                        # Need next byte to decide
+                        pos = None
+                        break
+                    if self.buffer[pos] == 0x55:
+                        pos += 1
+                    else:
+                        # Unescaped 0xFF, start of the next frame
+                        break
+                body.append(byte)
+                if len(body) == 2:
+                    expected = body[0] + 1 + (2 if body[1] & FLAG_CRC else 0)
+                if (expected is not None) and (len(body) == expected):
+                    break
+            if (pos is None) or (expected is None) or (len(body) < expected):
+                if (pos is not None) and (pos < len(self.buffer)):
+                    # Broken frame
+                    self.errors += 1
+                    del self.buffer[:2]
+                    continue
+                return frames
+            del self.buffer[:pos]
+            frame = self._parse(bytes(body))
+            if frame is None:
+                self.errors += 1
+            else:
+                frames.append(frame)
+
+    def _parse(self, body):
+        length = body[0]
+        if length < FRAME_HEADER_SIZE:
+            return None
+        if checksum(body[:length]) != body[length]:
+            return None
+        use_crc = (body[1] & FLAG_CRC) != 0
+        if use_crc and (crc16(body[:length]) != ((body[length + 1] << 8) | body[length + 2])):
+            return None
+        return Frame(body[7], body[FRAME_HEADER_SIZE:length], use_crc, body[2:7])
+
+
+class HonAppliance:
+    """hOn protocol appliance model."""
+
+    protocol = "hon"
+
+    def __init__(self, crc=True):
+        self.crc = crc
+        self.control = bytearray(HON_CONTROL_PACKET_SIZE)
+        self.control[0] = 24 - 16  # Set point
+        self.control[1] = 0x0C  # Vertical swing auto
+        self.control[2] = (0x01 << 5) | 0x05  # Cool, fan auto
+        self.control[4] = 0x02  # Display on
+        self.control[7] = 0x07  # Horizontal swing auto
+        self.room_temperature = 26.0
+        self.outdoor_temperature = 30
+        self.humidity = 45
+        self.compressor_frequency = 0
+        self.alarms = bytearray(HON_ALARMS_SIZE)
+        self.static = False
+
+    @property
+    def power(self):
+        return (self.control[5] & 0x01) != 0
+
+    @property
+    def set_point(self):
+        return self.control[0] + 16 + (0.5 if self.control[4] & 0x04 else 0.0)
+
+    def tick(self, seconds):
+        if self.static:
+            return
+        target = self.set_point if self.power else self.outdoor_temperature
+        step = min(abs(target - self.room_temperature), 0.05 * seconds)
+        self.room_temperature += step if target > self.room_temperature else -step
+        required = min(int(abs(self.set_point - self.room_temperature) * 20), 80) if self.power else 0
+        # Compressor changes frequency gradually
+        if required > self.compressor_frequency:
+            self.compressor_frequency = min(required, self.compressor_frequency + int(5 * seconds) + 1)
+        elif required < self.compressor_frequency:
+            self.compressor_frequency = max(required, self.compressor_frequency - int(5 * seconds) - 1)
+
+    def _status(self, subcommand, big_data=False):
+        sensors = bytearray(HON_SENSORS_PACKET_SIZE)
+        sensors[0] = int(round(self.room_temperature * 2))
+        sensors[1] = self.humidity
+        sensors[2] = self.outdoor_temperature + 64
+        sensors[5] = 0x03  # Operation source: ESP
+        data = bytes([subcommand >> 8, subcommand & 0xFF]) + bytes(self.control) + bytes(sensors)
+        if big_data:
+            power = self.compressor_frequency * 12
+            current = self.compressor_frequency // 2
+            big = bytearray(HON_BIG_DATA_PACKET_SIZE)
+            big[0:2] = power.to_bytes(2, "big")
+            big[2] = int((self.room_temperature + 20) * 2)
+            big[3] = self.outdoor_temperature + 64
+            big[4] = self.outdoor_temperature + 64
+            big[5] = self.outdoor_temperature + 64
+            big[6] = self.outdoor_temperature + 64
+            big[7] = self.compressor_frequency
+            big[8:10] = current.to_bytes(2, "big")
+            big[10] = 0x01 if self.compressor_frequency else 0x00
+            big[11] = (0x01 if self.compressor_frequency else 0x00) | ((0x01 if self.power else 0x00) << 2)
+            data += bytes(big)
+        return FRAME_STATUS, data
+
+    def _set_single_parameter(self, parameter, value):
+        def set_bits(index, shift, width):
+            mask = ((1 << width) - 1) << shift
+            self.control[index] = (self.control[index] & ~mask & 0xFF) | ((value << shift) & mask)
+
+        setters = {
+            0x01: (5, 0, 1),  # AC power
+            0x02: (0, 0, 8),  # Set point
+            0x03: (1, 0, 4),  # Vertical swing
+            0x04: (2, 5, 3),  # AC mode
+            0x05: (2, 0, 3),  # Fan mode
+            0x07: (4, 5, 1),  # Use Fahrenheit
+            0x09: (4, 1, 1),  # Display
+            0x0A: (4, 0, 1),  # 10 degree
+            0x0B: (5, 1, 1),  # Health mode
+            0x0C: (7, 0, 3),  # Horizontal swing
+            0x0D: (9, 4, 1),  # Self cleaning
+            0x17: (5, 6, 1),  # Lock remote
+            0x19: (5, 4, 1),  # Quiet mode
+            0x1A: (5, 3, 1),  # Fast mode
+            0x1B: (5, 5, 1),  # Sleep mode
+        }
+        if parameter in setters:
+            set_bits(*setters[parameter])
+        return parameter in setters or parameter == 0x16
+
+    def process(self, frame):
+        """Returns (frame_type, data) of the answer, list of them or None if frame should not be answered."""
+        ftype = frame.frame_type
+        if ftype == FRAME_GET_DEVICE_VERSION:
+            data = bytearray()
+            data += b"E++2.17\x00"  # Protocol version
+            data += b"17122708"  # Software version
+            data += b"\xF1\x00\x00"  # Encryption
+            data += b"U-AC\x00\x00\x00\x00"  # Hardware version
+            data += b"\x00"
+            data += b"HSIM-AC\x00"  # Device name
+            data += bytes([0x00, 0x04 if self.crc else 0x00])  # Functions
+            return FRAME_GET_DEVICE_VERSION_RESPONSE, bytes(data)
+        if ftype == FRAME_GET_DEVICE_ID:
+            return FRAME_GET_DEVICE_ID_RESPONSE, b"\x20" + b"SIMULATED-HAIER-APPLIANCE-000001".ljust(32, b"\x00")
+        if ftype == FRAME_GET_ALARM_STATUS:
+            return FRAME_GET_ALARM_STATUS_RESPONSE, b"\x0F\x5A" + bytes(self.alarms)
+        if ftype == FRAME_GET_MANAGEMENT_INFORMATION:
+            return FRAME_GET_MANAGEMENT_INFORMATION_RESPONSE, b"\x00\x00\x00\x00\x00\x00\x00\x00"
+        if ftype == FRAME_REPORT_NETWORK_STATUS:
+            return FRAME_CONFIRM, b""
+        if ftype == FRAME_CONFIRM:
+            return None
+        if ftype == FRAME_CONTROL and frame.subcommand is not None:
+            subcommand = frame.subcommand
+            if subcommand == HON_GET_USER_DATA:
+                return self._status(0x6D01)
+            if subcommand == HON_GET_BIG_DATA:
+                return self._status(0x7D01, True)
+            if subcommand == HON_SET_GROUP_PARAMETERS and len(frame.data) >= 2 + HON_CONTROL_PACKET_SIZE:
+                self.control[:] = frame.data[2 : 2 + HON_CONTROL_PACKET_SIZE]
+                # Beeper bit is not a state
+                self.control[5] &= 0x7F
+                return self._status(0x6D01)
+            if (subcommand & 0xFF00) == HON_SET_SINGLE_PARAMETER and len(frame.data) >= 4:
+                if self._set_single_parameter(subcommand & 0xFF, (frame.data[2] << 8) | frame.data[3]):
+                    return self._status(0x6D01)
+        return FRAME_INVALID, b""
+
+
+class Smartair2Appliance:
+    """smartAir2 protocol appliance model."""
+
+    protocol = "smartair2"
+
+    def __init__(self):
+        self.control = bytearray(SMARTAIR2_CONTROL_PACKET_SIZE)
+        self.control[5] = 0x7F
+        self.control[11] = 0x01  # Cool
+        self.control[13] = 0x03  # Fan auto
+        self.control[19] = 0x20  # Display on
+        self.control[23] = 24 - 16
+        self.room_temperature = 26.0
+        self.outdoor_temperature = 30
+        self.humidity = 45
+        self.static = False
+
+    @property
+    def power(self):
+        return (self.control[17] & 0x01) != 0
+
+    def tick(self, seconds):
+        if self.static:
+            return
+        target = (self.control[23] + 16) if self.power else self.outdoor_temperature
+        step = min(abs(target - self.room_temperature), 0.05 * seconds)
+        self.room_temperature += step if target > self.room_temperature else -step
+
+    def _status(self):
+        self.control[1] = int(self.room_temperature)
+        self.control[3] = self.humidity
+        self.control[5] = 0x7F
+        return FRAME_STATUS, b"\x6D\x01" + bytes(self.control)
+
+    def process(self, frame):
+        ftype = frame.frame_type
+        if ftype == FRAME_GET_DEVICE_VERSION:
+            # smartAir2 appliances don't support this request
+            return FRAME_INVALID, b""
+        if ftype == FRAME_REPORT_NETWORK_STATUS:
+            return FRAME_CONFIRM, b""
+        if ftype == FRAME_CONTROL and frame.subcommand is not None:
+            subcommand = frame.subcommand
+            if subcommand == SMARTAIR2_GET_STATUS:
+                return self._status()
+            if subcommand == SMARTAIR2_POWER_ON:
+                self.control[17] |= 0x01
+                return self._status()
+            if subcommand == SMARTAIR2_POWER_OFF:
+                self.control[17] &= 0xFE
+                return self._status()
+            if subcommand == SMARTAIR2_SET_CONTROL and len(frame.data) >= 2 + SMARTAIR2_CONTROL_PACKET_SIZE:
+                power = self.control[17] & 0x01
+                self.control[:] = frame.data[2 : 2 + SMARTAIR2_CONTROL_PACKET_SIZE]
+                # Power is changed only by power on/off commands
+                self.control[17] = (self.control[17] & 0xFE) | power
+                return self._status()
+        return FRAME_INVALID, b""
+
+
+class FrameEvent:
+    def __init__(self, timestamp, incoming, frame_type, subcommand, size):
+        self.timestamp = timestamp
+        self.incoming = incoming
+        self.frame_type = frame_type
+        self.subcommand = subcommand
+        self.size = size
+
+
+class Simulator:
+    """Serves the appliance model on a pty, all frames are registered in the event log."""
+
+    def __init__(self, appliance, port, answer_delay=0.0, verbose=False):
+        self.appliance = appliance
+        self.port = port
+        self.answer_delay = answer_delay
+        self.verbose = verbose
+        self.events = []
+        self.events_lock = threading.Lock()
+        self.decoder = FrameDecoder()
+        self._stop = threading.Event()
+        self._thread = None
+        self.master_fd, self.slave_fd = os.openpty()
+        tty.setraw(self.slave_fd)
+        if os.path.lexists(self.port):
+            os.unlink(self.port)
+        os.symlink(os.ttyname(self.slave_fd), self.port)
+
+    def start(self):
+        self._thread = threading.Thread(target=self.run, daemon=True)
+        self._thread.start()
+
+    def stop(self):
+        self._stop.set()
+        if self._thread is not None:
+            self._thread.join()
+        if os.path.islink(self.port):
+            os.unlink(self.port)
+        os.close(self.master_fd)
+        os.close(self.slave_fd)
+
+    def _register(self, incoming, frame_type, data):
+        subcommand = ((data[0] << 8) | data[1]) if len(data) >= 2 else None
+        with self.events_lock:
+            self.events.append(FrameEvent(time.monotonic(), incoming, frame_type, subcommand, len(data)))
+
+    def get_events(self):
+        with self.events_lock:
+            return list(self.events)
+
+    def run(self):
+        last_tick = time.monotonic()
+        while not self._stop.is_set():
+            ready, _, _ = select.select([self.master_fd], [], [], 0.1)
+            now = time.monotonic()
+            self.appliance.tick(now - last_tick)
+            last_tick = now
+            if not ready:
+                continue
+            try:
+                chunk = os.read(self.master_fd, 1024)
+            except OSError:
+                # Slave side is not opened yet
+                time.sleep(0.01)
+                continue
+            for frame in self.decoder.feed(chunk):
+                self._register(True, frame.frame_type, frame.data)
+                if self.verbose:
+                    print(f"<- {frame}", file=sys.stderr)
+                answer = self.appliance.process(frame)
+                if answer is None:
+                    continue
+                if self.answer_delay > 0:
+                    time.sleep(self.answer_delay)
+                # Appliance can send several frames in a row (answer and unsolicited messages)
+                for answer_type, answer_data in answer if isinstance(answer, list) else [answer]:
+                    os.write(self.master_fd, encode_frame(answer_type, answer_data, frame.use_crc, frame.reserved))
+                    self._register(False, answer_type, answer_data)
+                    if self.verbose:
+                        print(f"-> type {answer_type:02X}, data: {answer_data.hex(' ').upper()}", file=sys.stderr)
+
+
+def create_appliance(protocol, crc=True):
+    if protocol == "hon":
+        return HonAppliance(crc)
+    if protocol == "smartair2":
+        return Smartair2Appliance()
+    raise ValueError(f"Unknown protocol: {protocol}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Simulated Haier appliance on a pseudo-terminal")
+    parser.add_argument("--protocol", choices=["hon", "smartair2"], default="hon")
+    parser.add_argument("--port", default="/tmp/haier-simulator", help="symlink to the pty slave device")
+    parser.add_argument("--answer-delay", type=float, default=0.0, help="delay before each answer, seconds")
+    parser.add_argument("--no-crc", action="store_true", help="hOn appliance doesn't report CRC support")
+    parser.add_argument("--static", action="store_true", help="appliance state doesn't change by itself")
+    parser.add_argument("-v", "--verbose", action="store_true", help="print all frames")
+    args = parser.parse_args()
+    appliance = create_appliance(args.protocol, not args.no_crc)
+    appliance.static = args.static
+    simulator = Simulator(appliance, args.port, args.answer_delay, args.verbose)
+    print(f"Simulated {args.protocol} appliance is available on {args.port}", file=sys.stderr)
+    simulator.start()
+    try:
+        while True:
+            time.sleep(1)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        simulator.stop()
+
+
+if __name__ == "__main__":
+    main()
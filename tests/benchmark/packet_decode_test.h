@@ -0,0 +1,394 @@
+#pragma once
+
+// Decodes fixed status buffers through the packet structures and through the packet views and checks
+// that both give the same values, then feeds the same buffers to process_status_message_ and checks the
+// climate state. Included only by host-packet-decode-*.yaml configurations.
+#include <cstdint>
+#include <cstring>
+#include "esphome/core/log.h"
+#include "esphome/components/haier/hon_climate.h"
+#include "esphome/components/haier/smartair2_climate.h"
+#include "esphome/components/haier/smartair2_packet.h"
+
+namespace haier_benchmark {
+
+using namespace esphome;
+using namespace esphome::haier;
+
+static const char *const DECODE_TAG = "packet_decode";
+
+inline uint32_t check_value(const char *buffer_name, const char *field, float expected, float actual) {
+  if (expected == actual)
+    return 0;
+  ESP_LOGE(DECODE_TAG, "%s: %s mismatch, expected %.1f, got %.1f", buffer_name, field, expected, actual);
+  return 1;
+}
+
+struct FixedBuffer {
+  const char *name;
+  const uint8_t *data;
+  size_t size;
+};
+
+// hOn status: subtype, control packet (10 bytes), sensors packet (22 bytes) and big data (14 bytes) for 0x7D01
+constexpr size_t HON_USER_DATA_SIZE = 2 + sizeof(hon_protocol::HaierPacketControl) + 22;
+
+const uint8_t HON_COOL_STATUS[HON_USER_DATA_SIZE] = {
+    0x6D, 0x01,
+    // Control: 24°C, vertical swing auto, cool, fan mid, display on, power on, horizontal swing auto
+    0x08, 0x0C, 0x22, 0x00, 0x02, 0x01, 0x00, 0x07, 0x00, 0x00,
+    // Sensors: 24.5°C, 45%, outdoor 26°C, operation source ESP
+    0x31, 0x2D, 0x5A, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00};
+
+const uint8_t HON_HEAT_BIG_DATA[HON_USER_DATA_SIZE + sizeof(hon_protocol::HaierPacketBigData)] = {
+    0x7D, 0x01,
+    // Control: 22.5°C, vertical swing up, heat, fan auto, half degree, display on, power on, health, sleep
+    0x06, 0x04, 0x85, 0x00, 0x06, 0x23, 0x00, 0x00, 0x00, 0x00,
+    // Sensors: 20°C, 38%, outdoor -3°C
+    0x28, 0x26, 0x3D, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+    // Big data: 1234W, coil temperatures, 52Hz, 4.6A, fans and compressor on, valve 480
+    0x04, 0xD2, 0x78, 0x3B, 0x6E, 0x3C, 0x3A, 0x34, 0x00, 0x2E, 0x01, 0x15, 0x01, 0xE0};
+
+const uint8_t HON_FAST_FAN_ONLY[HON_USER_DATA_SIZE] = {
+    0x6D, 0x01,
+    // Control: 30°C, fan only, fan high, fast mode, power on, horizontal swing left
+    0x0E, 0x08, 0xC1, 0x00, 0x02, 0x09, 0x00, 0x04, 0x00, 0x00,
+    // Sensors: 27°C, 60%, outdoor 31°C
+    0x36, 0x3C, 0x5F, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00};
+
+const uint8_t HON_AUTO_OFF[HON_USER_DATA_SIZE] = {
+    0x6D, 0x01,
+    // Control: 25°C, auto, fan low, power off, ten degree
+    0x09, 0x0C, 0x03, 0x00, 0x03, 0x00, 0x00, 0x07, 0x00, 0x00,
+    // Sensors: 23°C, 50%, outdoor 15°C
+    0x2E, 0x32, 0x4F, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00};
+
+const uint8_t HON_PATTERN_A5[HON_USER_DATA_SIZE + sizeof(hon_protocol::HaierPacketBigData)] = {
+    0x7D, 0x01, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5,
+    0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5,
+    0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5};
+
+const uint8_t HON_PATTERN_5A[HON_USER_DATA_SIZE + sizeof(hon_protocol::HaierPacketBigData)] = {
+    0x7D, 0x01, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A,
+    0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A,
+    0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A};
+
+const FixedBuffer HON_STATUS_BUFFERS[] = {
+    {"hon cool", HON_COOL_STATUS, sizeof(HON_COOL_STATUS)},
+    {"hon heat big data", HON_HEAT_BIG_DATA, sizeof(HON_HEAT_BIG_DATA)},
+    {"hon fast fan only", HON_FAST_FAN_ONLY, sizeof(HON_FAST_FAN_ONLY)},
+    {"hon auto off", HON_AUTO_OFF, sizeof(HON_AUTO_OFF)},
+};
+
+const FixedBuffer HON_PATTERN_BUFFERS[] = {
+    {"hon pattern 0xA5", HON_PATTERN_A5, sizeof(HON_PATTERN_A5)},
+    {"hon pattern 0x5A", HON_PATTERN_5A, sizeof(HON_PATTERN_5A)},
+};
+
+inline uint32_t check_hon_views(const FixedBuffer &buffer) {
+  uint32_t failures = 0;
+  auto check = [&buffer, &failures](const char *field, unsigned expected, unsigned actual) {
+    failures += check_value(buffer.name, field, expected, actual);
+  };
+  const size_t control_offset = 2;
+  const size_t sensors_offset = control_offset + sizeof(hon_protocol::HaierPacketControl);
+  hon_protocol::HaierPacketControl control;
+  memcpy(&control, buffer.data + control_offset, sizeof(control));
+  hon_protocol::HaierPacketControlView control_view(buffer.data + control_offset, sizeof(control));
+  check("set_point", control.set_point, control_view.set_point());
+  check("vertical_swing_mode", control.vertical_swing_mode, control_view.vertical_swing_mode());
+  check("fan_mode", control.fan_mode, control_view.fan_mode());
+  check("special_mode", control.special_mode, control_view.special_mode());
+  check("ac_mode", control.ac_mode, control_view.ac_mode());
+  check("ten_degree", control.ten_degree, control_view.ten_degree());
+  check("display_status", control.display_status, control_view.display_status());
+  check("half_degree", control.half_degree, control_view.half_degree());
+  check("use_fahrenheit", control.use_fahrenheit, control_view.use_fahrenheit());
+  check("steri_clean", control.steri_clean, control_view.steri_clean());
+  check("ac_power", control.ac_power, control_view.ac_power());
+  check("health_mode", control.health_mode, control_view.health_mode());
+  check("fast_mode", control.fast_mode, control_view.fast_mode());
+  check("quiet_mode", control.quiet_mode, control_view.quiet_mode());
+  check("sleep_mode", control.sleep_mode, control_view.sleep_mode());
+  check("lock_remote", control.lock_remote, control_view.lock_remote());
+  check("beeper_status", control.beeper_status, control_view.beeper_status());
+  check("target_humidity", control.target_humidity, control_view.target_humidity());
+  check("horizontal_swing_mode", control.horizontal_swing_mode, control_view.horizontal_swing_mode());
+  check("self_cleaning_status", control.self_cleaning_status, control_view.self_cleaning_status());
+  hon_protocol::HaierPacketSensors sensors;
+  memcpy(&sensors, buffer.data + sensors_offset, sizeof(sensors));
+  hon_protocol::HaierPacketSensorsView sensors_view(buffer.data + sensors_offset, sizeof(sensors));
+  check("room_temperature", sensors.room_temperature, sensors_view.room_temperature());
+  check("room_humidity", sensors.room_humidity, sensors_view.room_humidity());
+  check("outdoor_temperature", sensors.outdoor_temperature, sensors_view.outdoor_temperature());
+  check("error_status", sensors.error_status, sensors_view.error_status());
+  const size_t big_data_offset = HON_USER_DATA_SIZE;
+  if (buffer.size >= big_data_offset + sizeof(hon_protocol::HaierPacketBigData)) {
+    hon_protocol::HaierPacketBigData big_data;
+    memcpy(&big_data, buffer.data + big_data_offset, sizeof(big_data));
+    hon_protocol::HaierPacketBigDataView big_data_view(buffer.data + big_data_offset, sizeof(big_data));
+    check("power", (big_data.power[0] << 8) | big_data.power[1], big_data_view.power());
+    check("indoor_coil_temperature", big_data.indoor_coil_temperature, big_data_view.indoor_coil_temperature());
+    check("outdoor_out_air_temperature", big_data.outdoor_out_air_temperature,
+          big_data_view.outdoor_out_air_temperature());
+    check("outdoor_coil_temperature", big_data.outdoor_coil_temperature, big_data_view.outdoor_coil_temperature());
+    check("outdoor_in_air_temperature", big_data.outdoor_in_air_temperature,
+          big_data_view.outdoor_in_air_temperature());
+    check("outdoor_defrost_temperature", big_data.outdoor_defrost_temperature,
+          big_data_view.outdoor_defrost_temperature());
+    check("compressor_frequency", big_data.compressor_frequency, big_data_view.compressor_frequency());
+    check("compressor_current", (big_data.compressor_current[0] << 8) | big_data.compressor_current[1],
+          big_data_view.compressor_current());
+    check("outdoor_fan_status", big_data.outdoor_fan_status, big_data_view.outdoor_fan_status());
+    check("defrost_status", big_data.defrost_status, big_data_view.defrost_status());
+    check("compressor_status", big_data.compressor_status, big_data_view.compressor_status());
+    check("indoor_fan_status", big_data.indoor_fan_status, big_data_view.indoor_fan_status());
+    check("four_way_valve_status", big_data.four_way_valve_status, big_data_view.four_way_valve_status());
+    check("indoor_electric_heating_status", big_data.indoor_electric_heating_status,
+          big_data_view.indoor_electric_heating_status());
+    check("expansion_valve_open_degree",
+          (big_data.expansion_valve_open_degree[0] << 8) | big_data.expansion_valve_open_degree[1],
+          big_data_view.expansion_valve_open_degree());
+  }
+  return failures;
+}
+
+// process_status_message_ is protected, member pointer taken through a derived class gives access to it
+struct HonClimateAccess : public HonClimate {
+  static haier_protocol::HandlerError process_status(HonClimate *climate, const uint8_t *data, uint8_t size) {
+    return (climate->*(&HonClimateAccess::process_status_message_))(data, size);
+  }
+};
+
+// Expected climate state is decoded with the packet structures
+inline uint32_t check_hon_status(HonClimate *climate, const FixedBuffer &buffer) {
+  uint32_t failures = 0;
+  if (HonClimateAccess::process_status(climate, buffer.data, buffer.size) !=
+      haier_protocol::HandlerError::HANDLER_OK) {
+    ESP_LOGE(DECODE_TAG, "%s: status processing failed", buffer.name);
+    return 1;
+  }
+  hon_protocol::HaierPacketControl control;
+  memcpy(&control, buffer.data + 2, sizeof(control));
+  hon_protocol::HaierPacketSensors sensors;
+  memcpy(&sensors, buffer.data + 2 + sizeof(control), sizeof(sensors));
+  climate::ClimateMode mode = climate::CLIMATE_MODE_OFF;
+  if (control.ac_power) {
+    switch ((hon_protocol::ConditioningMode) control.ac_mode) {
+      case hon_protocol::ConditioningMode::COOL:
+        mode = climate::CLIMATE_MODE_COOL;
+        break;
+      case hon_protocol::ConditioningMode::HEAT:
+        mode = climate::CLIMATE_MODE_HEAT;
+        break;
+      case hon_protocol::ConditioningMode::DRY:
+        mode = climate::CLIMATE_MODE_DRY;
+        break;
+      case hon_protocol::ConditioningMode::FAN:
+        mode = climate::CLIMATE_MODE_FAN_ONLY;
+        break;
+      default:
+        mode = climate::CLIMATE_MODE_HEAT_COOL;
+        break;
+    }
+  }
+  climate::ClimateFanMode fan_mode;
+  switch ((hon_protocol::FanMode) control.fan_mode) {
+    case hon_protocol::FanMode::FAN_HIGH:
+      fan_mode = climate::CLIMATE_FAN_HIGH;
+      break;
+    case hon_protocol::FanMode::FAN_MID:
+      fan_mode = climate::CLIMATE_FAN_MEDIUM;
+      break;
+    case hon_protocol::FanMode::FAN_LOW:
+      fan_mode = climate::CLIMATE_FAN_LOW;
+      break;
+    default:
+      fan_mode = climate::CLIMATE_FAN_AUTO;
+      break;
+  }
+  climate::ClimatePreset preset = climate::CLIMATE_PRESET_NONE;
+  if (control.fast_mode) {
+    preset = climate::CLIMATE_PRESET_BOOST;
+  } else if (control.sleep_mode) {
+    preset = climate::CLIMATE_PRESET_SLEEP;
+  } else if (control.ten_degree) {
+    preset = climate::CLIMATE_PRESET_AWAY;
+  }
+  failures += check_value(buffer.name, "mode", mode, climate->mode);
+  failures += check_value(buffer.name, "target temperature",
+                          control.set_point + 16.0f + (control.half_degree ? 0.5f : 0.0f), climate->target_temperature);
+  failures += check_value(buffer.name, "current temperature", sensors.room_temperature / 2.0f,
+                          climate->current_temperature);
+  failures += check_value(buffer.name, "fan mode", fan_mode, climate->fan_mode.value_or(climate::CLIMATE_FAN_ON));
+  failures += check_value(buffer.name, "preset", preset, climate->preset.value_or(climate::CLIMATE_PRESET_ECO));
+  return failures;
+}
+
+inline uint32_t check_hon_decoding(HonClimate *climate) {
+  uint32_t failures = 0;
+  for (const auto &buffer : HON_PATTERN_BUFFERS)
+    failures += check_hon_views(buffer);
+  for (const auto &buffer : HON_STATUS_BUFFERS) {
+    failures += check_hon_views(buffer);
+    failures += check_hon_status(climate, buffer);
+  }
+  return failures;
+}
+
+// smartAir2 status: subcommand and control packet (24 bytes)
+const uint8_t SMARTAIR2_COOL_STATUS[sizeof(smartair2_protocol::HaierStatus)] = {
+    0x6D, 0x01,
+    // Room temperature 25°C, humidity 48%, cool, fan mid, power on, display on, 23°C
+    0x00, 0x19, 0x00, 0x30, 0x00, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x07};
+
+const uint8_t SMARTAIR2_HEAT_STATUS[sizeof(smartair2_protocol::HaierStatus)] = {
+    0x6D, 0x01,
+    // Room temperature 18°C, humidity 40%, heat, fan auto, power on, health, half degree, turbo, 21.5°C
+    0x00, 0x12, 0x00, 0x28, 0x00, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00, 0x29,
+    0x00, 0x03, 0x00, 0x00, 0x00, 0x05};
+
+const uint8_t SMARTAIR2_DRY_QUIET[sizeof(smartair2_protocol::HaierStatus)] = {
+    0x6D, 0x01,
+    // Room temperature 27°C, humidity 65%, dry, fan low, power on, quiet, swing both, 26°C
+    0x00, 0x1B, 0x00, 0x41, 0x00, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x02, 0x00, 0x01, 0x00, 0x01,
+    0x00, 0x04, 0x00, 0x00, 0x00, 0x0A};
+
+const uint8_t SMARTAIR2_OFF_STATUS[sizeof(smartair2_protocol::HaierStatus)] = {
+    0x6D, 0x01,
+    // Room temperature 21°C, humidity 55%, fan only, fan high, power off, ten degree, 16°C
+    0x00, 0x15, 0x00, 0x37, 0x00, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+const uint8_t SMARTAIR2_PATTERN_A5[sizeof(smartair2_protocol::HaierStatus)] = {
+    0x6D, 0x01, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5,
+    0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5};
+
+const uint8_t SMARTAIR2_PATTERN_5A[sizeof(smartair2_protocol::HaierStatus)] = {
+    0x6D, 0x01, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A,
+    0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A};
+
+const FixedBuffer SMARTAIR2_STATUS_BUFFERS[] = {
+    {"smartair2 cool", SMARTAIR2_COOL_STATUS, sizeof(SMARTAIR2_COOL_STATUS)},
+    {"smartair2 heat", SMARTAIR2_HEAT_STATUS, sizeof(SMARTAIR2_HEAT_STATUS)},
+    {"smartair2 dry quiet", SMARTAIR2_DRY_QUIET, sizeof(SMARTAIR2_DRY_QUIET)},
+    {"smartair2 off", SMARTAIR2_OFF_STATUS, sizeof(SMARTAIR2_OFF_STATUS)},
+};
+
+const FixedBuffer SMARTAIR2_PATTERN_BUFFERS[] = {
+    {"smartair2 pattern 0xA5", SMARTAIR2_PATTERN_A5, sizeof(SMARTAIR2_PATTERN_A5)},
+    {"smartair2 pattern 0x5A", SMARTAIR2_PATTERN_5A, sizeof(SMARTAIR2_PATTERN_5A)},
+};
+
+inline uint32_t check_smartair2_views(const FixedBuffer &buffer) {
+  uint32_t failures = 0;
+  auto check = [&buffer, &failures](const char *field, unsigned expected, unsigned actual) {
+    failures += check_value(buffer.name, field, expected, actual);
+  };
+  smartair2_protocol::HaierPacketControl control;
+  memcpy(&control, buffer.data + 2, sizeof(control));
+  smartair2_protocol::HaierPacketControlView control_view(buffer.data + 2, sizeof(control));
+  check("room_temperature", control.room_temperature, control_view.room_temperature());
+  check("room_humidity", control.room_humidity, control_view.room_humidity());
+  check("ac_mode", control.ac_mode, control_view.ac_mode());
+  check("fan_mode", control.fan_mode, control_view.fan_mode());
+  check("swing_mode", control.swing_mode, control_view.swing_mode());
+  check("use_fahrenheit", control.use_fahrenheit, control_view.use_fahrenheit());
+  check("lock_remote", control.lock_remote, control_view.lock_remote());
+  check("ac_power", control.ac_power, control_view.ac_power());
+  check("health_mode", control.health_mode, control_view.health_mode());
+  check("half_degree", control.half_degree, control_view.half_degree());
+  check("ten_degree", control.ten_degree, control_view.ten_degree());
+  check("turbo_mode", control.turbo_mode, control_view.turbo_mode());
+  check("quiet_mode", control.quiet_mode, control_view.quiet_mode());
+  check("horizontal_swing", control.horizontal_swing, control_view.horizontal_swing());
+  check("vertical_swing", control.vertical_swing, control_view.vertical_swing());
+  check("display_status", control.display_status, control_view.display_status());
+  check("set_point", control.set_point, control_view.set_point());
+  return failures;
+}
+
+struct Smartair2ClimateAccess : public Smartair2Climate {
+  static haier_protocol::HandlerError process_status(Smartair2Climate *climate, const uint8_t *data, uint8_t size) {
+    return (climate->*(&Smartair2ClimateAccess::process_status_message_))(data, size);
+  }
+};
+
+inline uint32_t check_smartair2_status(Smartair2Climate *climate, const FixedBuffer &buffer) {
+  uint32_t failures = 0;
+  if (Smartair2ClimateAccess::process_status(climate, buffer.data, buffer.size) !=
+      haier_protocol::HandlerError::HANDLER_OK) {
+    ESP_LOGE(DECODE_TAG, "%s: status processing failed", buffer.name);
+    return 1;
+  }
+  smartair2_protocol::HaierPacketControl control;
+  memcpy(&control, buffer.data + 2, sizeof(control));
+  climate::ClimateMode mode = climate::CLIMATE_MODE_OFF;
+  if (control.ac_power) {
+    switch ((smartair2_protocol::ConditioningMode) control.ac_mode) {
+      case smartair2_protocol::ConditioningMode::COOL:
+        mode = climate::CLIMATE_MODE_COOL;
+        break;
+      case smartair2_protocol::ConditioningMode::HEAT:
+        mode = climate::CLIMATE_MODE_HEAT;
+        break;
+      case smartair2_protocol::ConditioningMode::DRY:
+        mode = climate::CLIMATE_MODE_DRY;
+        break;
+      case smartair2_protocol::ConditioningMode::FAN:
+        mode = climate::CLIMATE_MODE_FAN_ONLY;
+        break;
+      default:
+        mode = climate::CLIMATE_MODE_HEAT_COOL;
+        break;
+    }
+  }
+  climate::ClimateFanMode fan_mode;
+  switch ((smartair2_protocol::FanMode) control.fan_mode) {
+    case smartair2_protocol::FanMode::FAN_HIGH:
+      fan_mode = climate::CLIMATE_FAN_HIGH;
+      break;
+    case smartair2_protocol::FanMode::FAN_MID:
+      fan_mode = climate::CLIMATE_FAN_MEDIUM;
+      break;
+    case smartair2_protocol::FanMode::FAN_LOW:
+      fan_mode = climate::CLIMATE_FAN_LOW;
+      break;
+    default:
+      fan_mode = climate::CLIMATE_FAN_AUTO;
+      break;
+  }
+  climate::ClimatePreset preset = climate::CLIMATE_PRESET_NONE;
+  if (control.turbo_mode) {
+    preset = climate::CLIMATE_PRESET_BOOST;
+  } else if (control.quiet_mode) {
+    preset = climate::CLIMATE_PRESET_COMFORT;
+  } else if (control.ten_degree) {
+    preset = climate::CLIMATE_PRESET_AWAY;
+  }
+  failures += check_value(buffer.name, "mode", mode, climate->mode);
+  failures += check_value(buffer.name, "target temperature",
+                          control.set_point + 16.0f + (control.half_degree ? 0.5f : 0.0f), climate->target_temperature);
+  failures += check_value(buffer.name, "current temperature", control.room_temperature, climate->current_temperature);
+  failures += check_value(buffer.name, "fan mode", fan_mode, climate->fan_mode.value_or(climate::CLIMATE_FAN_ON));
+  failures += check_value(buffer.name, "preset", preset, climate->preset.value_or(climate::CLIMATE_PRESET_ECO));
+  return failures;
+}
+
+inline uint32_t check_smartair2_decoding(Smartair2Climate *climate) {
+  uint32_t failures = 0;
+  for (const auto &buffer : SMARTAIR2_PATTERN_BUFFERS)
+    failures += check_smartair2_views(buffer);
+  for (const auto &buffer : SMARTAIR2_STATUS_BUFFERS) {
+    failures += check_smartair2_views(buffer);
+    failures += check_smartair2_status(climate, buffer);
+  }
+  return failures;
+}
+
+}  // namespace haier_benchmark
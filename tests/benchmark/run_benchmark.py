@@ -0,0 +1,304 @@
+#!/usr/bin/env python3
+"""Performance benchmark of the Haier component running on the ESPHome host platform.
+
+Starts the simulated appliance (haier_simulator.py), runs the host binary built
+from host-benchmark-hon.yaml or host-benchmark-smartair2.yaml and measures:
+
+- time to first status: from the process start until the first status answer
+  is received by the component,
+- control latency: from the control request made by the benchmark
+  configuration until the control frame arrives to the appliance,
+- frames per second sent in both directions,
+- CPU time used by the process per loop() iteration and per second,
+- UART read calls per received frame and bytes read per second,
+- heap allocations per status request (host-allocations-*.yaml only).
+
+Usage:
+
+    esphome compile host-benchmark-hon.yaml
+    python3 run_benchmark.py --protocol hon --duration 60
+
+    esphome compile host-allocations-hon.yaml
+    python3 run_benchmark.py --protocol hon --config host-allocations-hon --static-appliance \
+        --max-allocations-per-status 0
+"""
+
+import argparse
+import json
+import os
+import pty
+import re
+import select
+import statistics
+import subprocess
+import sys
+import time
+
+import haier_simulator
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+ANSI_ESCAPE = re.compile(r"\x1b\[[0-9;]*m")
+FIRST_STATUS_RE = re.compile(r"First HVAC status received")
+CONTROL_REQUEST_RE = re.compile(r"\[benchmark(?::\d+)?\]: Control request (\d+)")
+LOOP_COUNTER_RE = re.compile(r"\[benchmark(?::\d+)?\]: Loop counter: (\d+)")
+ALLOCATIONS_RE = re.compile(r"\[benchmark(?::\d+)?\]: Heap allocations: (\d+)")
+UART_READS_RE = re.compile(r"\[benchmark(?::\d+)?\]: UART reads: (\d+) calls, (\d+) bytes")
+
+HON_CONTROL_SUBCOMMANDS = (haier_simulator.HON_SET_GROUP_PARAMETERS,)
+SMARTAIR2_CONTROL_SUBCOMMANDS = (
+    haier_simulator.SMARTAIR2_POWER_ON,
+    haier_simulator.SMARTAIR2_POWER_OFF,
+    haier_simulator.SMARTAIR2_SET_CONTROL,
+)
+
+
+def is_control_frame(protocol, event):
+    if (not event.incoming) or (event.frame_type != haier_simulator.FRAME_CONTROL) or (event.subcommand is None):
+        return False
+    if protocol == "hon":
+        return (event.subcommand in HON_CONTROL_SUBCOMMANDS) or (
+            (event.subcommand & 0xFF00) == haier_simulator.HON_SET_SINGLE_PARAMETER
+        )
+    return event.subcommand in SMARTAIR2_CONTROL_SUBCOMMANDS
+
+
+def is_status_answer(event):
+    return (not event.incoming) and (event.frame_type == haier_simulator.FRAME_STATUS)
+
+
+def read_cpu_time(pid):
+    # utime and stime fields of /proc/<pid>/stat, in clock ticks
+    with open(f"/proc/{pid}/stat", encoding="ascii") as stat_file:
+        fields = stat_file.read().rsplit(")", 1)[1].split()
+    return (int(fields[11]) + int(fields[12])) / os.sysconf("SC_CLK_TCK")
+
+
+def default_binary(name):
+    return os.path.join(SCRIPT_DIR, ".esphome", "build", name, ".pioenvs", name, "program")
+
+
+def percentile(values, share):
+    if not values:
+        return None
+    ordered = sorted(values)
+    return ordered[min(int(len(ordered) * share), len(ordered) - 1)]
+
+
+def describe(values, scale=1000.0):
+    if not values:
+        return None
+    return {
+        "count": len(values),
+        "min": min(values) * scale,
+        "avg": statistics.mean(values) * scale,
+        "p95": percentile(values, 0.95) * scale,
+        "max": max(values) * scale,
+    }
+
+
+class Benchmark:
+    def __init__(self, args):
+        self.args = args
+        self.start_time = None
+        self.first_status_log = None
+        self.control_requests = []
+        self.loop_counters = []
+        self.allocations = []
+        self.uart_reads = []
+        self.log = []
+
+    def process_line(self, timestamp, line):
+        line = ANSI_ESCAPE.sub("", line).rstrip()
+        if not line:
+            return
+        self.log.append(line)
+        if self.args.verbose:
+            print(line, file=sys.stderr)
+        if (self.first_status_log is None) and FIRST_STATUS_RE.search(line):
+            self.first_status_log = timestamp
+        match = CONTROL_REQUEST_RE.search(line)
+        if match:
+            self.control_requests.append(timestamp)
+        match = LOOP_COUNTER_RE.search(line)
+        if match:
+            self.loop_counters.append((timestamp, int(match.group(1)), read_cpu_time(self.pid)))
+        match = ALLOCATIONS_RE.search(line)
+        if match:
+            self.allocations.append((timestamp, int(match.group(1))))
+        match = UART_READS_RE.search(line)
+        if match:
+            self.uart_reads.append((timestamp, int(match.group(1)), int(match.group(2))))
+
+    def run(self):
+        args = self.args
+        config = args.config or f"host-benchmark-{args.protocol}"
+        binary = args.binary or default_binary(config)
+        if not os.path.isfile(binary):
+            sys.exit(f"Host binary not found: {binary}, compile {config}.yaml first")
+        appliance = haier_simulator.create_appliance(args.protocol, not args.no_crc)
+        appliance.static = args.static_appliance
+        simulator = haier_simulator.Simulator(appliance, args.port, args.answer_delay)
+        simulator.start()
+        # Use pty for output to get line buffered logs
+        out_master, out_slave = pty.openpty()
+        self.start_time = time.monotonic()
+        process = subprocess.Popen([binary], stdout=out_slave, stderr=out_slave, stdin=subprocess.DEVNULL)
+        os.close(out_slave)
+        self.pid = process.pid
+        pending = b""
+        try:
+            while time.monotonic() - self.start_time < args.duration:
+                ready, _, _ = select.select([out_master], [], [], 0.1)
+                if not ready:
+                    if process.poll() is not None:
+                        break
+                    continue
+                timestamp = time.monotonic()
+                try:
+                    chunk = os.read(out_master, 4096)
+                except OSError:
+                    break
+                pending += chunk
+                *lines, pending = pending.split(b"\n")
+                for line in lines:
+                    self.process_line(timestamp, line.decode("utf-8", "replace"))
+        finally:
+            end_time = time.monotonic()
+            if process.poll() is None:
+                process.terminate()
+                process.wait()
+            os.close(out_master)
+            simulator.stop()
+        if process.returncode not in (None, 0, -15):
+            print(f"Host binary exited with code {process.returncode}", file=sys.stderr)
+        return self.evaluate(simulator.get_events(), simulator.decoder.errors, end_time)
+
+    def evaluate(self, events, decoder_errors, end_time):
+        protocol = self.args.protocol
+        result = {"protocol": protocol, "duration_s": end_time - self.start_time}
+        first_answer = next((e.timestamp for e in events if is_status_answer(e)), None)
+        result["time_to_first_status_answer_ms"] = (
+            (first_answer - self.start_time) * 1000.0 if first_answer is not None else None
+        )
+        result["time_to_first_status_ms"] = (
+            (self.first_status_log - self.start_time) * 1000.0 if self.first_status_log is not None else None
+        )
+        # Control latency: request in configuration -> first control frame on the appliance side,
+        # control done: request -> status answer after the last control frame of the request
+        control_frames = [e for e in events if is_control_frame(protocol, e)]
+        latencies = []
+        done_latencies = []
+        for index, request in enumerate(self.control_requests):
+            next_request = (
+                self.control_requests[index + 1] if index + 1 < len(self.control_requests) else float("inf")
+            )
+            frames = [e for e in control_frames if request <= e.timestamp < next_request]
+            if not frames:
+                continue
+            latencies.append(frames[0].timestamp - request)
+            answer = next(
+                (e for e in events if is_status_answer(e) and e.timestamp >= frames[-1].timestamp), None
+            )
+            if answer is not None:
+                done_latencies.append(answer.timestamp - request)
+        result["control_requests"] = len(self.control_requests)
+        result["control_latency_ms"] = describe(latencies)
+        result["control_done_latency_ms"] = describe(done_latencies)
+        # Throughput is measured after protocol initialization
+        window_start = first_answer if first_answer is not None else self.start_time
+        window = max(end_time - window_start, 1e-6)
+        window_events = [e for e in events if e.timestamp >= window_start]
+        result["frames_per_second"] = len(window_events) / window
+        result["requests_per_second"] = len([e for e in window_events if e.incoming]) / window
+        result["bytes_per_second"] = sum(e.size for e in window_events) / window
+        result["frame_errors"] = decoder_errors
+        if len(self.loop_counters) >= 2:
+            (t0, loops0, cpu0), (t1, loops1, cpu1) = self.loop_counters[0], self.loop_counters[-1]
+            loops = max(loops1 - loops0, 1)
+            result["loops_per_second"] = loops / (t1 - t0)
+            result["cpu_per_loop_us"] = (cpu1 - cpu0) * 1e6 / loops
+            result["cpu_load_percent"] = (cpu1 - cpu0) * 100.0 / (t1 - t0)
+        # UART ingestion: read calls per frame sent by the appliance
+        if len(self.uart_reads) >= 2:
+            (t0, calls0, bytes0), (t1, calls1, bytes1) = self.uart_reads[0], self.uart_reads[-1]
+            answers = len([e for e in events if (not e.incoming) and t0 <= e.timestamp < t1])
+            result["read_calls_per_frame"] = (calls1 - calls0) / max(answers, 1)
+            result["bytes_read_per_second"] = (bytes1 - bytes0) / (t1 - t0)
+        # Steady state allocations: samples taken after warm-up period
+        if first_answer is not None:
+            samples = [s for s in self.allocations if s[0] >= first_answer + self.args.warmup]
+            if len(samples) >= 2:
+                (t0, allocations0), (t1, allocations1) = samples[0], samples[-1]
+                answers = len([e for e in events if is_status_answer(e) and t0 <= e.timestamp < t1])
+                result["status_answers_in_allocations_window"] = answers
+                result["allocations_per_status"] = (allocations1 - allocations0) / max(answers, 1)
+        return result
+
+
+def print_report(result):
+    def value(v, unit=""):
+        return "n/a" if v is None else f"{v:.2f}{unit}"
+
+    print(f"Protocol:                   {result['protocol']}")
+    print(f"Duration:                   {value(result['duration_s'], ' s')}")
+    print(f"Time to first status:       {value(result['time_to_first_status_ms'], ' ms')}")
+    print(f"First status answer sent:   {value(result['time_to_first_status_answer_ms'], ' ms')}")
+    for key, title in (("control_latency_ms", "Control latency"), ("control_done_latency_ms", "Control done")):
+        stats = result[key]
+        if stats is None:
+            print(f"{title + ':':28}n/a")
+        else:
+            print(
+                f"{title + ':':28}avg {stats['avg']:.2f} ms, min {stats['min']:.2f} ms, "
+                f"p95 {stats['p95']:.2f} ms, max {stats['max']:.2f} ms ({stats['count']} requests)"
+            )
+    print(f"Frames per second:          {value(result['frames_per_second'])}")
+    print(f"Requests per second:        {value(result['requests_per_second'])}")
+    print(f"Bytes per second:           {value(result['bytes_per_second'])}")
+    print(f"Frame errors:               {result['frame_errors']}")
+    print(f"Loops per second:           {value(result.get('loops_per_second'))}")
+    print(f"CPU time per loop:          {value(result.get('cpu_per_loop_us'), ' us')}")
+    print(f"CPU load:                   {value(result.get('cpu_load_percent'), ' %')}")
+    print(f"UART reads per frame:       {value(result.get('read_calls_per_frame'))}")
+    print(f"Bytes read per second:      {value(result.get('bytes_read_per_second'))}")
+    if "allocations_per_status" in result:
+        print(
+            f"Allocations per status:     {value(result['allocations_per_status'])} "
+            f"({result['status_answers_in_allocations_window']} status answers)"
+        )
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Haier component benchmark on the ESPHome host platform")
+    parser.add_argument("--protocol", choices=["hon", "smartair2"], default="hon")
+    parser.add_argument("--config", help="name of the configuration, default: host-benchmark-<protocol>")
+    parser.add_argument("--binary", help="host program, default: .esphome build of the configuration")
+    parser.add_argument("--port", default="/tmp/haier-simulator", help="must match port in the benchmark yaml")
+    parser.add_argument("--duration", type=float, default=60.0, help="benchmark duration, seconds")
+    parser.add_argument("--answer-delay", type=float, default=0.0, help="appliance answer delay, seconds")
+    parser.add_argument("--no-crc", action="store_true", help="hOn appliance doesn't report CRC support")
+    parser.add_argument("--static-appliance", action="store_true", help="appliance state doesn't change by itself")
+    parser.add_argument("--warmup", type=float, default=20.0, help="seconds after the first status to skip")
+    parser.add_argument(
+        "--max-allocations-per-status", type=float, help="fail if there are more heap allocations per status"
+    )
+    parser.add_argument("--json", help="save results to json file")
+    parser.add_argument("-v", "--verbose", action="store_true", help="print host program log")
+    args = parser.parse_args()
+    result = Benchmark(args).run()
+    print_report(result)
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as json_file:
+            json.dump(result, json_file, indent=2)
+    if args.max_allocations_per_status is not None:
+        allocations = result.get("allocations_per_status")
+        if allocations is None:
+            sys.exit("No heap allocation data, use host-allocations-<protocol>.yaml and longer duration")
+        if result["status_answers_in_allocations_window"] == 0:
+            sys.exit("No status answers after warm-up, heap allocations can't be checked")
+        if allocations > args.max_allocations_per_status:
+            sys.exit(f"Too many heap allocations per status: {allocations:.2f}")
+
+
+if __name__ == "__main__":
+    main()